@@ -151,6 +151,9 @@ public:
     WEBKIT_EXPORT static void enableQuota(bool);
     WEBKIT_EXPORT static bool isQuotaEnabled();
 
+    WEBKIT_EXPORT static void enableRecordedLayerContents(bool);
+    WEBKIT_EXPORT static bool isRecordedLayerContentsEnabled();
+
     WEBKIT_EXPORT static void enableRequestAutocomplete(bool);
     WEBKIT_EXPORT static bool isRequestAutocompleteEnabled();
 
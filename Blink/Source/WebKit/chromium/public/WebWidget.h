@@ -119,6 +119,11 @@ public:
     // warranted before painting again).
     virtual void paint(WebCanvas*, const WebRect& viewPort, PaintOptions = ReadbackFromCompositorIfAvailable) { }
 
+    // Called once the frame begun with animate() has been painted, or
+    // committed to the compositor, with the monotonic time at which the
+    // next frame begins. The time until then may be used for idle work.
+    virtual void didPaintFrame(double monotonicFrameDeadline) { }
+
     // Returns true if we've started tracking repaint rectangles.
     virtual bool isTrackingRepaints() const { return false; }
 
@@ -279,6 +279,16 @@ bool WebRuntimeFeatures::isQuotaEnabled()
     return RuntimeEnabledFeatures::quotaEnabled();
 }
 
+void WebRuntimeFeatures::enableRecordedLayerContents(bool enable)
+{
+    RuntimeEnabledFeatures::setRecordedLayerContentsEnabled(enable);
+}
+
+bool WebRuntimeFeatures::isRecordedLayerContentsEnabled()
+{
+    return RuntimeEnabledFeatures::recordedLayerContentsEnabled();
+}
+
 void WebRuntimeFeatures::enableMediaStream(bool enable)
 {
     RuntimeEnabledFeatures::setMediaStreamEnabled(enable);
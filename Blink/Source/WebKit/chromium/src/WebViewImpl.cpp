@@ -72,6 +72,7 @@
 #include "WebSettingsImpl.h"
 #include "WebTextInputInfo.h"
 #include "WebViewClient.h"
+#include "bindings/v8/V8GCController.h"
 #include "core/accessibility/AXObjectCache.h"
 #include "core/css/StyleResolver.h"
 #include "core/dom/Document.h"
@@ -1881,6 +1882,13 @@ void WebViewImpl::paint(WebCanvas* canvas, const WebRect& rect, PaintOptions opt
     }
 }
 
+void WebViewImpl::didPaintFrame(double monotonicFrameDeadline)
+{
+    // Style, layout and paint of this frame are done, so garbage collection work that ends before the
+    // deadline doesn't delay the next frame.
+    V8GCController::idleNotificationUntil(monotonicFrameDeadline);
+}
+
 bool WebViewImpl::isTrackingRepaints() const
 {
     if (!page())
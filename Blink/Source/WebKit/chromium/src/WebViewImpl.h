@@ -147,6 +147,7 @@ public:
     virtual void layout();
     virtual void enterForceCompositingMode(bool enable) OVERRIDE;
     virtual void paint(WebCanvas*, const WebRect&, PaintOptions = ReadbackFromCompositorIfAvailable);
+    virtual void didPaintFrame(double monotonicFrameDeadline) OVERRIDE;
     virtual bool isTrackingRepaints() const OVERRIDE;
     virtual void themeChanged();
     virtual void setNeedsRedraw();
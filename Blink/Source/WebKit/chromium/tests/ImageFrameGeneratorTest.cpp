@@ -74,6 +74,8 @@ public:
         m_decodersDestroyed = 0;
         m_frameBufferRequestCount = 0;
         m_frameStatus = ImageFrame::FrameEmpty;
+        m_lookUpScaledImageDuringDecode = false;
+        m_scaledImageFoundDuringDecode = 0;
     }
 
     virtual void TearDown()
@@ -89,6 +91,10 @@ public:
     virtual void frameBufferRequested()
     {
         ++m_frameBufferRequestCount;
+        if (m_lookUpScaledImageDuringDecode) {
+            ThreadIdentifier threadID = createThread(&lookUpScaledImageThreadMain, this, "LookUpThread");
+            waitForThreadCompletion(threadID);
+        }
     }
 
     virtual ImageFrame::FrameStatus frameStatus()
@@ -113,11 +119,21 @@ protected:
 
     void setFrameStatus(ImageFrame::FrameStatus status)  { m_frameStatus = status; }
 
+    static void lookUpScaledImageThreadMain(void* arg)
+    {
+        ImageFrameGeneratorTest* test = reinterpret_cast<ImageFrameGeneratorTest*>(arg);
+        test->m_scaledImageFoundDuringDecode = test->m_generator->decodeAndScale(scaledSize());
+        if (test->m_scaledImageFoundDuringDecode)
+            ImageDecodingStore::instance()->unlockCache(test->m_generator.get(), test->m_scaledImageFoundDuringDecode);
+    }
+
     RefPtr<SharedBuffer> m_data;
     RefPtr<ImageFrameGenerator> m_generator;
     int m_decodersDestroyed;
     int m_frameBufferRequestCount;
     ImageFrame::FrameStatus m_frameStatus;
+    bool m_lookUpScaledImageDuringDecode;
+    const ScaledImageFragment* m_scaledImageFoundDuringDecode;
 };
 
 PassOwnPtr<ImageDecoder> MockImageDecoderFactory::create()
@@ -309,6 +325,25 @@ TEST_F(ImageFrameGeneratorTest, incompleteDecodeAndScaleBecomesComplete)
     EXPECT_EQ(2, m_frameBufferRequestCount);
 }
 
+TEST_F(ImageFrameGeneratorTest, completeCacheHitDuringDecode)
+{
+    WTF::initializeThreading();
+    const ScaledImageFragment* scaledImage = ImageDecodingStore::instance()->insertAndLockCache(
+        m_generator.get(), createCompleteImage(scaledSize()));
+    ImageDecodingStore::instance()->unlockCache(m_generator.get(), scaledImage);
+
+    // The complete scaled image is looked up on another thread while this
+    // thread is decoding the full size image, and must not wait for it.
+    setFrameStatus(ImageFrame::FramePartial);
+    m_lookUpScaledImageDuringDecode = true;
+    const ScaledImageFragment* tempImage = m_generator->decodeAndScale(fullSize());
+    EXPECT_FALSE(tempImage->isComplete());
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(scaledImage, m_scaledImageFoundDuringDecode);
+    ImageDecodingStore::instance()->unlockCache(m_generator.get(), tempImage);
+    EXPECT_EQ(2u, ImageDecodingStore::instance()->cacheEntries());
+}
+
 static void decodeThreadMain(void* arg)
 {
     ImageFrameGenerator* generator = reinterpret_cast<ImageFrameGenerator*>(arg);
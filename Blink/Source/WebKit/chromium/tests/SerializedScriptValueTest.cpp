@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2013 Google Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "bindings/v8/SerializedScriptValue.h"
+
+#include "FrameTestHelpers.h"
+#include "WebFrame.h"
+#include "WebFrameImpl.h"
+#include "WebView.h"
+#include "bindings/v8/ScriptController.h"
+#include "bindings/v8/V8Binding.h"
+#include "core/page/Frame.h"
+
+#include <gtest/gtest.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+using namespace WebKit;
+
+namespace {
+
+class SerializedScriptValueTest : public testing::Test {
+public:
+    SerializedScriptValueTest()
+        : m_webView(0)
+    {
+    }
+
+    void SetUp() OVERRIDE
+    {
+        m_webView = FrameTestHelpers::createWebViewAndLoad("about:blank");
+    }
+
+    void TearDown() OVERRIDE
+    {
+        m_webView->close();
+    }
+
+    v8::Handle<v8::Context> context()
+    {
+        return static_cast<WebFrameImpl*>(m_webView->mainFrame())->frame()->script()->mainWorldContext();
+    }
+
+    v8::Handle<v8::Value> roundTrip(v8::Handle<v8::Value> value)
+    {
+        RefPtr<SerializedScriptValue> serializedValue = SerializedScriptValue::create(value, v8::Isolate::GetCurrent());
+        return serializedValue->deserialize();
+    }
+
+    // The bytes are given in stream order, as they would be stored on disk.
+    v8::Handle<v8::Value> deserializeBytes(const uint8_t* data, size_t length)
+    {
+        Vector<uint8_t> bytes;
+        bytes.append(data, length);
+        RefPtr<SerializedScriptValue> serializedValue = SerializedScriptValue::createFromWireBytes(bytes);
+        return serializedValue->deserialize();
+    }
+
+private:
+    WebView* m_webView;
+};
+
+int32_t int32Property(v8::Handle<v8::Value> object, const char* name)
+{
+    return object.As<v8::Object>()->Get(v8::String::New(name))->Int32Value();
+}
+
+String stringProperty(v8::Handle<v8::Value> object, const char* name)
+{
+    return toWebCoreString(object.As<v8::Object>()->Get(v8::String::New(name)));
+}
+
+TEST_F(SerializedScriptValueTest, OneByteStringRoundTrip)
+{
+    v8::HandleScope handleScope;
+    v8::Context::Scope scope(context());
+
+    // Characters above 0x7F must survive without being widened or mangled.
+    const uint8_t latin1[] = { 'c', 'a', 'f', 0xE9 };
+    v8::Handle<v8::String> string = v8::String::NewFromOneByte(v8::Isolate::GetCurrent(), latin1, v8::String::kNormalString, sizeof(latin1));
+    v8::Handle<v8::Value> result = roundTrip(string);
+
+    ASSERT_TRUE(result->IsString());
+    String resultString = toWebCoreString(result);
+    ASSERT_EQ(4u, resultString.length());
+    EXPECT_EQ(0xE9, resultString[3]);
+    EXPECT_TRUE(resultString.startsWith("caf"));
+
+    result = roundTrip(v8::String::New(""));
+    ASSERT_TRUE(result->IsString());
+    EXPECT_EQ(0, result.As<v8::String>()->Length());
+}
+
+TEST_F(SerializedScriptValueTest, SharedPropertyNamesRoundTrip)
+{
+    v8::HandleScope handleScope;
+    v8::Context::Scope scope(context());
+
+    // Every record after the first refers to the names of the first one.
+    const int recordCount = 3;
+    const UChar twoByteName[] = { 0x043A, 0x043B, 0x044E, 0x0447 };
+    v8::Handle<v8::String> twoByteKey = v8::String::New(twoByteName, WTF_ARRAY_LENGTH(twoByteName));
+    v8::Local<v8::Array> records = v8::Array::New(recordCount);
+    for (int i = 0; i < recordCount; ++i) {
+        v8::Local<v8::Object> record = v8::Object::New();
+        record->Set(v8::String::New("name"), v8::String::New(String::number(i).utf8().data()));
+        record->Set(v8::String::New("value"), v8::Integer::New(i * 10));
+        record->Set(twoByteKey, v8::Integer::New(i + 1));
+        records->Set(i, record);
+    }
+
+    v8::Handle<v8::Value> result = roundTrip(records);
+
+    ASSERT_TRUE(result->IsArray());
+    ASSERT_EQ(static_cast<uint32_t>(recordCount), result.As<v8::Array>()->Length());
+    for (int i = 0; i < recordCount; ++i) {
+        v8::Handle<v8::Value> record = result.As<v8::Array>()->Get(i);
+        ASSERT_TRUE(record->IsObject());
+        EXPECT_TRUE(stringProperty(record, "name") == String::number(i));
+        EXPECT_EQ(i * 10, int32Property(record, "value"));
+        EXPECT_EQ(i + 1, record.As<v8::Object>()->Get(twoByteKey)->Int32Value());
+    }
+}
+
+TEST_F(SerializedScriptValueTest, ReadsPropertyNameTable)
+{
+    v8::HandleScope handleScope;
+    v8::Context::Scope scope(context());
+
+    // {x: {x: 1}}, with the inner name referring to the outer one.
+    const uint8_t data[] = {
+        0xFF, 0x03, // Version 3.
+        'o', // Outer object.
+        'k', '"', 0x01, 'x', // Name "x", entry 0 of the name table.
+        'o', // Inner object.
+        'K', 0x00, // Name table entry 0.
+        'I', 0x02, // 1.
+        '{', 0x01, // End of the inner object.
+        '{', 0x01, // End of the outer object.
+    };
+    v8::Handle<v8::Value> result = deserializeBytes(data, sizeof(data));
+
+    ASSERT_TRUE(result->IsObject());
+    v8::Handle<v8::Value> inner = result.As<v8::Object>()->Get(v8::String::New("x"));
+    ASSERT_TRUE(inner->IsObject());
+    EXPECT_EQ(1, int32Property(inner, "x"));
+
+    // A reference past the end of the name table is rejected.
+    const uint8_t badReference[] = {
+        0xFF, 0x03,
+        'o',
+        'K', 0x01,
+        'I', 0x02,
+        '{', 0x01,
+        0x00,
+    };
+    EXPECT_TRUE(deserializeBytes(badReference, sizeof(badReference))->IsNull());
+}
+
+TEST_F(SerializedScriptValueTest, ReadsVersion2Streams)
+{
+    v8::HandleScope handleScope;
+    v8::Context::Scope scope(context());
+
+    // {foo: "bar"} as written by version 2, with UTF-8 strings and no name table.
+    const uint8_t data[] = {
+        0xFF, 0x02,
+        'o',
+        'S', 0x03, 'f', 'o', 'o',
+        'S', 0x03, 'b', 'a', 'r',
+        '{', 0x01,
+        0x00,
+    };
+    v8::Handle<v8::Value> result = deserializeBytes(data, sizeof(data));
+
+    ASSERT_TRUE(result->IsObject());
+    EXPECT_TRUE(stringProperty(result, "foo") == "bar");
+
+    // Non-ASCII characters are UTF-8 encoded in version 2.
+    const uint8_t utf8[] = {
+        0xFF, 0x02,
+        'S', 0x05, 'c', 'a', 'f', 0xC3, 0xA9,
+        0x00,
+    };
+    result = deserializeBytes(utf8, sizeof(utf8));
+    ASSERT_TRUE(result->IsString());
+    String resultString = toWebCoreString(result);
+    ASSERT_EQ(4u, resultString.length());
+    EXPECT_EQ(0xE9, resultString[3]);
+}
+
+TEST_F(SerializedScriptValueTest, RejectsVersion3TagsInVersion2Streams)
+{
+    v8::HandleScope handleScope;
+    v8::Context::Scope scope(context());
+
+    const uint8_t oneByteString[] = { 0xFF, 0x02, '"', 0x01, 'a', 0x00 };
+    EXPECT_TRUE(deserializeBytes(oneByteString, sizeof(oneByteString))->IsNull());
+
+    const uint8_t propertyName[] = { 0xFF, 0x02, 'o', 'k', '"', 0x01, 'x', 'I', 0x02, '{', 0x01, 0x00 };
+    EXPECT_TRUE(deserializeBytes(propertyName, sizeof(propertyName))->IsNull());
+
+    const uint8_t propertyNameReference[] = { 0xFF, 0x02, 'K', 0x00 };
+    EXPECT_TRUE(deserializeBytes(propertyNameReference, sizeof(propertyNameReference))->IsNull());
+}
+
+} // namespace
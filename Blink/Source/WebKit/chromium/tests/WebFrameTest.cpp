@@ -45,6 +45,7 @@
 #include "WebFrameImpl.h"
 #include "WebHistoryItem.h"
 #include "WebRange.h"
+#include "WebRuntimeFeatures.h"
 #include "WebScriptSource.h"
 #include "WebSearchableFormData.h"
 #include "WebSecurityOrigin.h"
@@ -55,6 +56,7 @@
 #include "WebTextCheckingResult.h"
 #include "WebViewClient.h"
 #include "WebViewImpl.h"
+#include "bindings/v8/V8GCController.h"
 #include "core/dom/DocumentMarkerController.h"
 #include "core/dom/Range.h"
 #include "core/editing/FrameSelection.h"
@@ -66,6 +68,7 @@
 #include "core/platform/graphics/FloatRect.h"
 #include "core/platform/network/ResourceError.h"
 #include "core/rendering/HitTestResult.h"
+#include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderLayerCompositor.h"
 #include "core/rendering/RenderView.h"
 #include "v8.h"
@@ -2997,5 +3000,206 @@ TEST_F(WebFrameTest, CompositorScrollIsUserScrollShortPage)
     m_webView = 0;
 }
 
+TEST_F(WebFrameTest, LazyBlockGeometryQueriesLayOutSkippedChildren)
+{
+    WebRuntimeFeatures::enableLazyLayout(true);
+    registerMockedHttpURLLoad("lazy_block_geometry.html");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "lazy_block_geometry.html", true);
+    m_webView->resize(WebSize(200, 200));
+    m_webView->layout();
+
+    // Both elements sit in children of the lazy block far below the
+    // viewport, which only got an estimated height. Querying them has to
+    // lay those children out, and querying the second one must not undo
+    // the layout forced by the first.
+    Document* document = static_cast<WebFrameImpl*>(m_webView->mainFrame())->frame()->document();
+    Element* first = document->getElementById("first");
+    Element* second = document->getElementById("second");
+    EXPECT_EQ(50, first->clientWidth());
+    EXPECT_EQ(100, first->clientHeight());
+    EXPECT_EQ(120, second->scrollHeight());
+    EXPECT_EQ(60, second->clientWidth());
+    EXPECT_EQ(100, first->scrollHeight());
+    EXPECT_EQ(100, first->boundsInRootViewSpace().height());
+
+    m_webView->close();
+    m_webView = 0;
+    WebRuntimeFeatures::enableLazyLayout(false);
+}
+
+TEST_F(WebFrameTest, LastLineEndingInForcedBreakWrapsWhenNarrowed)
+{
+    registerMockedHttpURLLoad("line_boxes_forced_break.html");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "line_boxes_forced_break.html", true);
+    m_webView->resize(WebSize(300, 300));
+    m_webView->layout();
+
+    Document* document = static_cast<WebFrameImpl*>(m_webView->mainFrame())->frame()->document();
+    Element* brBlock = document->getElementById("br");
+    Element* preBlock = document->getElementById("pre");
+    int brHeight = brBlock->offsetHeight();
+    int preHeight = preBlock->offsetHeight();
+
+    // Only the width of the blocks changes. Their last lines end in forced breaks and no longer fit,
+    // so they have to wrap although the earlier lines are kept.
+    m_webView->mainFrame()->executeScript(WebScriptSource("document.getElementById('container').style.width = '50px';"));
+    m_webView->layout();
+    EXPECT_GT(brBlock->offsetHeight(), brHeight);
+    EXPECT_GT(preBlock->offsetHeight(), preHeight);
+
+    m_webView->close();
+    m_webView = 0;
+}
+
+TEST_F(WebFrameTest, MajorGCPrologueWalksEachDetachedAncestorOnce)
+{
+    registerMockedHttpURLLoad("gc_opaque_roots.html");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "gc_opaque_roots.html", true);
+
+    m_webView->mainFrame()->collectGarbage();
+
+    // Walking up from every wrapper to its root would take about depth * depth / 2 steps for each
+    // tree. Attributes of connected elements take none, and each detached element is walked once.
+    EXPECT_LE(WebCore::V8GCController::lastMajorGCOpaqueRootAncestorStepsForTesting(), 501u);
+
+    // The wrappers were grouped with their roots, so their expandos survive.
+    m_webView->mainFrame()->executeScript(WebScriptSource(
+        "var lost = 0;"
+        "for (var e = document.getElementById('deepest'); e.id != 'container'; e = e.parentNode)"
+        "    lost += e.getAttributeNode('data-level').expando === undefined;"
+        "for (var e = detachedRoot.firstChild; e; e = e.firstChild)"
+        "    lost += e.expando === undefined;"
+        "document.title = lost;"));
+    EXPECT_EQ("0", m_webView->mainFrame()->document().title().utf8());
+
+    m_webView->close();
+    m_webView = 0;
+}
+
+static Element* elementAtPoint(WebView* webView, const WebCore::IntPoint& point)
+{
+    WebCore::Node* node = static_cast<WebViewImpl*>(webView)->mainFrameImpl()->frame()->eventHandler()->hitTestResultAtPoint(point).innerNode();
+    return node && node->isElementNode() ? WebCore::toElement(node) : 0;
+}
+
+TEST_F(WebFrameTest, HitTestFindsChildAfterItMoves)
+{
+    registerMockedHttpURLLoad("hit_test_moved_child.html");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "hit_test_moved_child.html", true);
+    m_webView->resize(WebSize(300, 1200));
+    m_webView->layout();
+
+    // The container has enough children for hit testing to index them.
+    Document* document = static_cast<WebFrameImpl*>(m_webView->mainFrame())->frame()->document();
+    EXPECT_EQ(document->getElementById("c10"), elementAtPoint(m_webView, WebCore::IntPoint(50, 210)));
+
+    // A style change that doesn't move anything keeps the children where they were hit before.
+    m_webView->mainFrame()->executeScript(WebScriptSource("document.getElementById('c10').style.color = 'red';"));
+    m_webView->layout();
+    EXPECT_EQ(document->getElementById("c10"), elementAtPoint(m_webView, WebCore::IntPoint(50, 210)));
+
+    // Growing c5 moves the children after it down, so the old position of c10 now hits c5.
+    m_webView->mainFrame()->executeScript(WebScriptSource("document.getElementById('c5').style.height = '200px';"));
+    m_webView->layout();
+    EXPECT_EQ(document->getElementById("c5"), elementAtPoint(m_webView, WebCore::IntPoint(50, 210)));
+    EXPECT_EQ(document->getElementById("c10"), elementAtPoint(m_webView, WebCore::IntPoint(50, 390)));
+
+    // Removing c5 moves them back up.
+    m_webView->mainFrame()->executeScript(WebScriptSource("document.getElementById('container').removeChild(document.getElementById('c5'));"));
+    m_webView->layout();
+    EXPECT_EQ(document->getElementById("c11"), elementAtPoint(m_webView, WebCore::IntPoint(50, 210)));
+
+    m_webView->close();
+    m_webView = 0;
+}
+
+void paintFrameView(WebView* webView, float scale, const WebCore::IntRect& paintRect, SkBitmap* bitmap)
+{
+    bitmap->setConfig(SkBitmap::kARGB_8888_Config, 300, 300);
+    bitmap->allocPixels();
+    bitmap->eraseColor(0);
+    SkCanvas canvas(*bitmap);
+    canvas.scale(scale, scale);
+
+    WebCore::GraphicsContext context(&canvas);
+    static_cast<WebViewImpl*>(webView)->mainFrameImpl()->frameView()->paint(&context, paintRect);
+}
+
+bool bitmapsAreEqual(const SkBitmap& a, const SkBitmap& b)
+{
+    SkAutoLockPixels lockA(a);
+    SkAutoLockPixels lockB(b);
+    return a.getSize() == b.getSize() && !memcmp(a.getPixels(), b.getPixels(), a.getSize());
+}
+
+TEST_F(WebFrameTest, RecordedLayerContentsPaintLikeTheLayer)
+{
+    registerMockedHttpURLLoad("recorded_layer_contents.html");
+    registerMockedHttpURLLoad("radient.gif");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "recorded_layer_contents.html");
+    m_webView->resize(WebSize(300, 300));
+    m_webView->layout();
+
+    WebCore::IntRect fullRect(0, 0, 300, 300);
+    WebCore::IntRect partialRect(0, 0, 50, 50);
+    SkBitmap expected;
+    paintFrameView(m_webView, 1, fullRect, &expected);
+    SkBitmap expectedPartial;
+    paintFrameView(m_webView, 1, partialRect, &expectedPartial);
+
+    WebRuntimeFeatures::enableRecordedLayerContents(true);
+
+    // The second paint of unchanged contents records them, later ones replay the recording.
+    SkBitmap bitmap;
+    paintFrameView(m_webView, 1, partialRect, &bitmap);
+    EXPECT_FALSE(WebCore::RenderLayer::hasRecordedContents());
+    paintFrameView(m_webView, 1, partialRect, &bitmap);
+    EXPECT_TRUE(WebCore::RenderLayer::hasRecordedContents());
+    EXPECT_TRUE(bitmapsAreEqual(expectedPartial, bitmap));
+    paintFrameView(m_webView, 1, partialRect, &bitmap);
+    EXPECT_TRUE(bitmapsAreEqual(expectedPartial, bitmap));
+
+    // Only the dirty rect was recorded, so a larger paint drops the recording and paints directly.
+    paintFrameView(m_webView, 1, fullRect, &bitmap);
+    EXPECT_FALSE(WebCore::RenderLayer::hasRecordedContents());
+    EXPECT_TRUE(bitmapsAreEqual(expected, bitmap));
+    paintFrameView(m_webView, 1, fullRect, &bitmap);
+    EXPECT_TRUE(WebCore::RenderLayer::hasRecordedContents());
+    EXPECT_TRUE(bitmapsAreEqual(expected, bitmap));
+    paintFrameView(m_webView, 1, fullRect, &bitmap);
+    EXPECT_TRUE(bitmapsAreEqual(expected, bitmap));
+
+    m_webView->close();
+    m_webView = 0;
+    WebRuntimeFeatures::enableRecordedLayerContents(false);
+}
+
+TEST_F(WebFrameTest, RecordedLayerContentsNeedWholePixelTranslation)
+{
+    registerMockedHttpURLLoad("recorded_layer_contents.html");
+    registerMockedHttpURLLoad("radient.gif");
+    m_webView = FrameTestHelpers::createWebViewAndLoad(m_baseURL + "recorded_layer_contents.html");
+    m_webView->resize(WebSize(300, 300));
+    m_webView->layout();
+
+    // The image is resampled for the scale of the canvas, which a recording made without it would miss.
+    WebCore::IntRect paintRect(0, 0, 200, 200);
+    SkBitmap expected;
+    paintFrameView(m_webView, 1.5, paintRect, &expected);
+
+    WebRuntimeFeatures::enableRecordedLayerContents(true);
+
+    SkBitmap bitmap;
+    for (int i = 0; i < 3; ++i) {
+        paintFrameView(m_webView, 1.5, paintRect, &bitmap);
+        EXPECT_FALSE(WebCore::RenderLayer::hasRecordedContents());
+        EXPECT_TRUE(bitmapsAreEqual(expected, bitmap));
+    }
+
+    m_webView->close();
+    m_webView = 0;
+    WebRuntimeFeatures::enableRecordedLayerContents(false);
+}
+
 
 } // namespace
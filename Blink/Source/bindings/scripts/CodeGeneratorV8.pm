@@ -4528,8 +4528,7 @@ sub GenerateFunctionCallString
         AddToImplIncludes("V8$returnType.h");
         AddToImplIncludes("core/svg/properties/SVGPropertyTearOff.h");
         my $svgNativeType = GetSVGTypeNeedingTearOff($returnType);
-        # FIXME: Update for all ScriptWrappables.
-        if (IsDOMNodeType($interfaceName)) {
+        if (!$function->isStatic) {
             $code .= $indent . "return toV8Fast${forMainWorldSuffix}(WTF::getPtr(${svgNativeType}::create($return)), args, imp);\n";
         } else {
             $code .= $indent . "return toV8${forMainWorldSuffix}(WTF::getPtr(${svgNativeType}::create($return)), args.Holder(), args.GetIsolate());\n";
@@ -4545,8 +4544,7 @@ sub GenerateFunctionCallString
     $return .= ".release()" if ($returnIsRef);
 
     my $nativeValue;
-    # FIXME: Update for all ScriptWrappables.
-    if (IsDOMNodeType($interfaceName)) {
+    if (!$function->isStatic) {
         $nativeValue = NativeToJSValue($function->signature, $return, "args.Holder()", "args.GetIsolate()", "args", "imp", "ReturnUnsafeHandle", $forMainWorldSuffix);
     } else {
         $nativeValue = NativeToJSValue($function->signature, $return, "args.Holder()", "args.GetIsolate()", 0, 0, "ReturnUnsafeHandle", $forMainWorldSuffix);
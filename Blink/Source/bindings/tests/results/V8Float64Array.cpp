@@ -103,7 +103,7 @@ static v8::Handle<v8::Value> fooMethod(const v8::Arguments& args)
         return throwNotEnoughArgumentsError(args.GetIsolate());
     Float64Array* imp = V8Float64Array::toNative(args.Holder());
     V8TRYCATCH(Float32Array*, array, V8Float32Array::HasInstance(args[0], args.GetIsolate(), worldType(args.GetIsolate())) ? V8Float32Array::toNative(v8::Handle<v8::Object>::Cast(args[0])) : 0);
-    return toV8(imp->foo(array), args.Holder(), args.GetIsolate());
+    return toV8Fast(imp->foo(array), args, imp);
 }
 
 static v8::Handle<v8::Value> fooMethodCallback(const v8::Arguments& args)
@@ -103,7 +103,7 @@ static v8::Handle<v8::Value> itemMethod(const v8::Arguments& args)
         ec = INDEX_SIZE_ERR;
         goto fail;
     }
-    return toV8(imp->item(index), args.Holder(), args.GetIsolate());
+    return toV8Fast(imp->item(index), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -120,7 +120,7 @@ static v8::Handle<v8::Value> namedItemMethod(const v8::Arguments& args)
         return throwNotEnoughArgumentsError(args.GetIsolate());
     TestEventTarget* imp = V8TestEventTarget::toNative(args.Holder());
     V8TRYCATCH_FOR_V8STRINGRESOURCE(V8StringResource<>, name, args[0]);
-    return toV8(imp->namedItem(name), args.Holder(), args.GetIsolate());
+    return toV8Fast(imp->namedItem(name), args, imp);
 }
 
 static v8::Handle<v8::Value> namedItemMethodCallback(const v8::Arguments& args)
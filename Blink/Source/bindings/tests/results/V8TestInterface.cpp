@@ -422,7 +422,7 @@ static v8::Handle<v8::Value> supplementalMethod2Method(const v8::Arguments& args
     RefPtr<TestObj> result = TestPartialInterface::supplementalMethod2(scriptContext, imp, strArg, objArg, ec);
     if (UNLIKELY(ec))
         goto fail;
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -2410,7 +2410,7 @@ static v8::Handle<v8::Value> longMethodWithArgsMethodCallback(const v8::Argument
 static v8::Handle<v8::Value> objMethodMethod(const v8::Arguments& args)
 {
     TestObj* imp = V8TestObj::toNative(args.Holder());
-    return toV8(imp->objMethod(), args.Holder(), args.GetIsolate());
+    return toV8Fast(imp->objMethod(), args, imp);
 }
 
 static v8::Handle<v8::Value> objMethodMethodCallback(const v8::Arguments& args)
@@ -2427,7 +2427,7 @@ static v8::Handle<v8::Value> objMethodWithArgsMethod(const v8::Arguments& args)
     V8TRYCATCH(int, longArg, toInt32(args[0]));
     V8TRYCATCH_FOR_V8STRINGRESOURCE(V8StringResource<>, strArg, args[1]);
     V8TRYCATCH(TestObj*, objArg, V8TestObj::HasInstance(args[2], args.GetIsolate(), worldType(args.GetIsolate())) ? V8TestObj::toNative(v8::Handle<v8::Object>::Cast(args[2])) : 0);
-    return toV8(imp->objMethodWithArgs(longArg, strArg, objArg), args.Holder(), args.GetIsolate());
+    return toV8Fast(imp->objMethodWithArgs(longArg, strArg, objArg), args, imp);
 }
 
 static v8::Handle<v8::Value> objMethodWithArgsMethodCallback(const v8::Arguments& args)
@@ -2494,7 +2494,7 @@ static v8::Handle<v8::Value> methodThatRequiresAllArgsAndThrowsMethod(const v8::
     RefPtr<TestObj> result = imp->methodThatRequiresAllArgsAndThrows(strArg, objArg, ec);
     if (UNLIKELY(ec))
         goto fail;
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -2639,7 +2639,7 @@ static v8::Handle<v8::Value> withScriptStateObjMethod(const v8::Arguments& args)
         state.clearException();
         return throwError(exception, args.GetIsolate());
     }
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
 }
 
 static v8::Handle<v8::Value> withScriptStateObjMethodCallback(const v8::Arguments& args)
@@ -2692,7 +2692,7 @@ static v8::Handle<v8::Value> withScriptStateObjExceptionMethod(const v8::Argumen
         state.clearException();
         return throwError(exception, args.GetIsolate());
     }
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -2756,7 +2756,7 @@ static v8::Handle<v8::Value> withScriptExecutionContextAndScriptStateObjExceptio
         state.clearException();
         return throwError(exception, args.GetIsolate());
     }
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -2781,7 +2781,7 @@ static v8::Handle<v8::Value> withScriptExecutionContextAndScriptStateWithSpacesM
         state.clearException();
         return throwError(exception, args.GetIsolate());
     }
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
 }
 
 static v8::Handle<v8::Value> withScriptExecutionContextAndScriptStateWithSpacesMethodCallback(const v8::Arguments& args)
@@ -3461,7 +3461,7 @@ static v8::Handle<v8::Value> domStringListFunctionMethod(const v8::Arguments& ar
     RefPtr<DOMStringList> result = imp->domStringListFunction(values, ec);
     if (UNLIKELY(ec))
         goto fail;
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -3482,7 +3482,7 @@ static v8::Handle<v8::Value> getSVGDocumentMethod(const v8::Arguments& args)
     RefPtr<SVGDocument> result = imp->getSVGDocument(ec);
     if (UNLIKELY(ec))
         goto fail;
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -3556,7 +3556,7 @@ static v8::Handle<v8::Value> convert5MethodCallback(const v8::Arguments& args)
 static v8::Handle<v8::Value> mutablePointFunctionMethod(const v8::Arguments& args)
 {
     TestObj* imp = V8TestObj::toNative(args.Holder());
-    return toV8(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->mutablePointFunction())), args.Holder(), args.GetIsolate());
+    return toV8Fast(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->mutablePointFunction())), args, imp);
 }
 
 static v8::Handle<v8::Value> mutablePointFunctionMethodCallback(const v8::Arguments& args)
@@ -3567,7 +3567,7 @@ static v8::Handle<v8::Value> mutablePointFunctionMethodCallback(const v8::Argume
 static v8::Handle<v8::Value> immutablePointFunctionMethod(const v8::Arguments& args)
 {
     TestObj* imp = V8TestObj::toNative(args.Holder());
-    return toV8(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->immutablePointFunction())), args.Holder(), args.GetIsolate());
+    return toV8Fast(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->immutablePointFunction())), args, imp);
 }
 
 static v8::Handle<v8::Value> immutablePointFunctionMethodCallback(const v8::Arguments& args)
@@ -3600,7 +3600,7 @@ static v8::Handle<v8::Value> strictFunctionMethod(const v8::Arguments& args)
     RefPtr<bool> result = imp->strictFunction(str, a, b, ec);
     if (UNLIKELY(ec))
         goto fail;
-    return toV8(result.release(), args.Holder(), args.GetIsolate());
+    return toV8Fast(result.release(), args, imp);
     }
     fail:
     return setDOMException(ec, args.GetIsolate());
@@ -4034,7 +4034,7 @@ static const V8DOMConfiguration::BatchedAttribute V8TestObjAttrs[] = {
     {"reflectedCustomIntegralAttr", TestObjV8Internal::reflectedCustomIntegralAttrAttrGetterCallback, TestObjV8Internal::reflectedCustomIntegralAttrAttrSetterCallback, 0, 0, 0 /* no data */, static_cast<v8::AccessControl>(v8::DEFAULT), static_cast<v8::PropertyAttribute>(v8::None), 0 /* on instance */},
     // Attribute 'reflectedCustomBooleanAttr' (Type: 'attribute' ExtAttr: 'Reflect')
     {"reflectedCustomBooleanAttr", TestObjV8Internal::reflectedCustomBooleanAttrAttrGetterCallback, TestObjV8Internal::reflectedCustomBooleanAttrAttrSetterCallback, 0, 0, 0 /* no data */, static_cast<v8::AccessControl>(v8::DEFAULT), static_cast<v8::PropertyAttribute>(v8::None), 0 /* on instance */},
-    // Attribute 'reflectedCustomURLAttr' (Type: 'attribute' ExtAttr: 'URL Reflect')
+    // Attribute 'reflectedCustomURLAttr' (Type: 'attribute' ExtAttr: 'Reflect URL')
     {"reflectedCustomURLAttr", TestObjV8Internal::reflectedCustomURLAttrAttrGetterCallback, TestObjV8Internal::reflectedCustomURLAttrAttrSetterCallback, 0, 0, 0 /* no data */, static_cast<v8::AccessControl>(v8::DEFAULT), static_cast<v8::PropertyAttribute>(v8::None), 0 /* on instance */},
     // Attribute 'typedArrayAttr' (Type: 'attribute' ExtAttr: '')
     {"typedArrayAttr", TestObjV8Internal::typedArrayAttrAttrGetterCallback, TestObjV8Internal::typedArrayAttrAttrSetterCallback, 0, 0, 0 /* no data */, static_cast<v8::AccessControl>(v8::DEFAULT), static_cast<v8::PropertyAttribute>(v8::None), 0 /* on instance */},
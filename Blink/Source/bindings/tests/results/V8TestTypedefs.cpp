@@ -377,7 +377,7 @@ static v8::Handle<v8::Value> funcWithClampMethodCallback(const v8::Arguments& ar
 static v8::Handle<v8::Value> immutablePointFunctionMethod(const v8::Arguments& args)
 {
     TestTypedefs* imp = V8TestTypedefs::toNative(args.Holder());
-    return toV8(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->immutablePointFunction())), args.Holder(), args.GetIsolate());
+    return toV8Fast(WTF::getPtr(SVGPropertyTearOff<FloatPoint>::create(imp->immutablePointFunction())), args, imp);
 }
 
 static v8::Handle<v8::Value> immutablePointFunctionMethodCallback(const v8::Arguments& args)
@@ -68,6 +68,7 @@
 #include "wtf/ByteOrder.h"
 #include "wtf/Float32Array.h"
 #include "wtf/Float64Array.h"
+#include "wtf/HashMap.h"
 #include "wtf/Int16Array.h"
 #include "wtf/Int32Array.h"
 #include "wtf/Int8Array.h"
@@ -77,6 +78,7 @@
 #include "wtf/Uint8Array.h"
 #include "wtf/Uint8ClampedArray.h"
 #include "wtf/Vector.h"
+#include "wtf/text/StringHash.h"
 
 // FIXME: consider crashing in debug mode on deserialization errors
 // NOTE: be sure to change wireFormatVersion as necessary!
@@ -167,6 +169,7 @@ typedef UChar BufferValueType;
 // WebCoreStrings are read as (length:uint32_t, string:UTF8[length]).
 // RawStrings are read as (length:uint32_t, string:UTF8[length]).
 // RawUCharStrings are read as (length:uint32_t, string:UChar[length/sizeof(UChar)]).
+// RawOneByteStrings are read as (length:uint32_t, string:Latin1[length]).
 // RawFiles are read as (path:WebCoreString, url:WebCoreStrng, type:WebCoreString).
 // There is a reference table that maps object references (uint32_t) to v8::Values.
 // Tokens marked with (ref) are inserted into the reference table and given the next object reference ID after decoding.
@@ -176,6 +179,9 @@ typedef UChar BufferValueType;
 //     contain self-references. Before we begin to deserialize the contents of these values, they
 //     are first given object reference IDs (by GenerateFreshObjectTag/GenerateFreshArrayTag);
 //     these reference IDs are then used with ObjectReferenceTag to tie the recursive knot.
+// Property names are shared through a separate name table: the first occurrence of a name is
+//     written with PropertyNameTag and appended to the table, and every later object with the
+//     same layout refers to it by index with PropertyNameReferenceTag.
 enum SerializationTag {
     InvalidTag = '!', // Causes deserialization to fail.
     PaddingTag = '\0', // Is ignored (but consumed).
@@ -185,6 +191,9 @@ enum SerializationTag {
     FalseTag = 'F', // -> <false>
     StringTag = 'S', // string:RawString -> string
     StringUCharTag = 'c', // string:RawUCharString -> string
+    OneByteStringTag = '"', // string:RawOneByteString -> string
+    PropertyNameTag = 'k', // string:(OneByteStringTag | StringUCharTag) -> string. Appends the string to the property name table.
+    PropertyNameReferenceTag = 'K', // index:uint32_t -> property name table[index]
     Int32Tag = 'I', // value:ZigZag-encoded int32 -> Integer
     Uint32Tag = 'U', // value:uint32_t -> Integer
     DateTag = 'D', // value:double -> Date (ref)
@@ -241,7 +250,8 @@ static bool shouldCheckForCycles(int depth)
 
 // Increment this for each incompatible change to the wire format.
 // Version 2: Added StringUCharTag for UChar v8 strings.
-static const uint32_t wireFormatVersion = 2;
+// Version 3: Added OneByteStringTag for Latin-1 v8 strings and the property name table.
+static const uint32_t wireFormatVersion = 3;
 
 static const int maxDepth = 20000;
 
@@ -310,22 +320,16 @@ public:
 
     void writeOneByteString(v8::Handle<v8::String>& string)
     {
-        int stringLength = string->Length();
-        int utf8Length = string->Utf8Length();
-        ASSERT(stringLength >= 0 && utf8Length >= 0);
+        int length = string->Length();
+        ASSERT(length >= 0);
 
-        append(StringTag);
-        doWriteUint32(static_cast<uint32_t>(utf8Length));
-        ensureSpace(utf8Length);
-
-        // ASCII fast path.
-        if (stringLength == utf8Length)
-            string->WriteOneByte(byteAt(m_position), 0, utf8Length, v8StringWriteOptions());
-        else {
-            char* buffer = reinterpret_cast<char*>(byteAt(m_position));
-            string->WriteUtf8(buffer, utf8Length, 0, v8StringWriteOptions());
-        }
-        m_position += utf8Length;
+        // Latin-1 strings are copied as is; unlike UTF-8 this never widens
+        // characters above 0x7F and needs no separate length pass.
+        append(OneByteStringTag);
+        doWriteUint32(static_cast<uint32_t>(length));
+        ensureSpace(length);
+        string->WriteOneByte(byteAt(m_position), 0, length, v8StringWriteOptions());
+        m_position += length;
     }
 
     void writeUCharString(v8::Handle<v8::String>& string)
@@ -348,6 +352,17 @@ public:
         m_position += size;
     }
 
+    void writePropertyName()
+    {
+        append(PropertyNameTag);
+    }
+
+    void writePropertyNameReference(uint32_t index)
+    {
+        append(PropertyNameReferenceTag);
+        doWriteUint32(index);
+    }
+
     void writeStringObject(const char* data, int length)
     {
         ASSERT(length >= 0);
@@ -741,6 +756,29 @@ public:
     // Functions used by serialization states.
     StateBase* doSerialize(v8::Handle<v8::Value> value, StateBase* next);
 
+    // Serializes a property name, sharing it with every earlier object that had
+    // a property of the same name.
+    StateBase* doSerializePropertyName(v8::Handle<v8::Value> name, StateBase* next)
+    {
+        // Anything under more than one accessor is written as null by
+        // doSerialize(), property names included; keep that instead of
+        // adding such names to the table.
+        if (m_execDepth + next->execDepth() > 1) {
+            m_writer.writeNull();
+            return 0;
+        }
+        if (!name->IsString() || !name.As<v8::String>()->Length())
+            return doSerialize(name, next);
+        PropertyNameTable::AddResult result = m_propertyNameTable.add(toWebCoreString(name), m_propertyNameTable.size());
+        if (!result.isNewEntry) {
+            m_writer.writePropertyNameReference(result.iterator->value);
+            return 0;
+        }
+        m_writer.writePropertyName();
+        writeString(name);
+        return 0;
+    }
+
     StateBase* checkException(StateBase* state)
     {
         return m_tryCatch.HasCaught() ? handleError(JSException, state) : 0;
@@ -876,7 +914,7 @@ private:
                 ASSERT(!m_propertyName.IsEmpty());
                 if (!m_nameDone) {
                     m_nameDone = true;
-                    if (StateBase* newState = serializer.doSerialize(m_propertyName, this))
+                    if (StateBase* newState = serializer.doSerializePropertyName(m_propertyName, this))
                         return newState;
                 }
                 v8::Local<v8::Value> value = composite()->Get(m_propertyName);
@@ -1228,6 +1266,8 @@ private:
     ObjectPool m_objectPool;
     ObjectPool m_transferredMessagePorts;
     ObjectPool m_transferredArrayBuffers;
+    typedef HashMap<String, uint32_t> PropertyNameTable;
+    PropertyNameTable m_propertyNameTable;
     uint32_t m_nextObjectReference;
     Vector<String>& m_blobURLs;
     v8::Isolate* m_isolate;
@@ -1403,6 +1443,29 @@ public:
             if (!readUCharString(value))
                 return false;
             break;
+        case OneByteStringTag:
+            if (m_version < 3)
+                return false;
+            if (!readOneByteString(value, v8::String::kNormalString))
+                return false;
+            break;
+        case PropertyNameTag:
+            if (m_version < 3)
+                return false;
+            if (!readPropertyName(value))
+                return false;
+            break;
+        case PropertyNameReferenceTag: {
+            if (m_version < 3)
+                return false;
+            uint32_t index;
+            if (!doReadUint32(&index))
+                return false;
+            if (index >= m_propertyNames.size())
+                return false;
+            *value = m_propertyNames[index];
+            break;
+        }
         case StringObjectTag:
             if (!readStringObject(value))
                 return false;
@@ -1644,6 +1707,42 @@ private:
         return true;
     }
 
+    bool readOneByteString(v8::Handle<v8::Value>* value, v8::String::NewStringType type)
+    {
+        uint32_t length;
+        if (!doReadUint32(&length))
+            return false;
+        if (m_position + length > m_length)
+            return false;
+        *value = v8::String::NewFromOneByte(m_isolate, m_buffer + m_position, type, length);
+        m_position += length;
+        return true;
+    }
+
+    bool readPropertyName(v8::Handle<v8::Value>* value)
+    {
+        // UChar names may be padded to keep their payload aligned.
+        SerializationTag tag;
+        do {
+            if (!readTag(&tag))
+                return false;
+        } while (tag == PaddingTag);
+        if (tag == OneByteStringTag) {
+            // Names are internalized up front so that V8 does not have to
+            // look each of them up again when the object is filled.
+            if (!readOneByteString(value, v8::String::kInternalizedString))
+                return false;
+        } else if (tag == StringUCharTag) {
+            if (!readUCharString(value))
+                return false;
+        } else
+            return false;
+        if (value->IsEmpty())
+            return false;
+        m_propertyNames.append(value->As<v8::String>());
+        return true;
+    }
+
     bool readStringObject(v8::Handle<v8::Value>* value)
     {
         v8::Handle<v8::Value> stringValue;
@@ -1964,6 +2063,7 @@ private:
     unsigned m_position;
     uint32_t m_version;
     v8::Isolate* m_isolate;
+    Vector<v8::Handle<v8::String> > m_propertyNames;
 };
 
 
@@ -44,6 +44,8 @@
 #include "core/platform/MemoryUsageSupport.h"
 #include "core/platform/chromium/TraceEvent.h"
 #include <algorithm>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashMap.h>
 
 namespace WebCore {
 
@@ -86,6 +88,64 @@ Node* V8GCController::opaqueRootForGC(Node* node, v8::Isolate*)
     return node;
 }
 
+static size_t lastMajorGCOpaqueRootAncestorSteps = 0;
+
+// The opaque root of a node cannot change while a GC prologue runs, so the
+// root found for a detached node is remembered for every ancestor on the way
+// up. Without this, a detached tree with many wrappers is walked up to its
+// root once per wrapper, which is quadratic for deep trees. Connected nodes
+// and the attributes of connected elements never walk, as their root is the
+// document.
+class OpaqueRootCache {
+public:
+    OpaqueRootCache()
+        : m_ancestorSteps(0)
+    {
+    }
+
+    Node* opaqueRootForGC(Node* node, v8::Isolate* isolate)
+    {
+        if (node->isAttributeNode()) {
+            Node* ownerElement = static_cast<Attr*>(node)->ownerElement();
+            if (!ownerElement)
+                return node;
+            node = ownerElement;
+        } else if (node->hasTagName(HTMLNames::imgTag)) {
+            // Detached images with pending loads need the special case of V8GCController::opaqueRootForGC().
+            return V8GCController::opaqueRootForGC(node, isolate);
+        }
+
+        if (node->inDocument())
+            return node->document();
+
+        Vector<Node*, 32> path;
+        Node* root = 0;
+        while (!root) {
+            HashMap<Node*, Node*>::iterator it = m_roots.find(node);
+            if (it != m_roots.end()) {
+                root = it->value;
+                break;
+            }
+            path.append(node);
+            ++m_ancestorSteps;
+            Node* parent = node->parentOrShadowHostNode();
+            if (!parent)
+                root = node;
+            node = parent;
+        }
+        for (size_t i = 0; i < path.size(); ++i)
+            m_roots.set(path[i], root);
+        return root;
+    }
+
+    // The number of nodes walked to find roots, for tracing the cost of a prologue.
+    size_t ancestorSteps() const { return m_ancestorSteps; }
+
+private:
+    HashMap<Node*, Node*> m_roots;
+    size_t m_ancestorSteps;
+};
+
 // Regarding a minor GC algorithm for DOM nodes, see this document:
 // https://docs.google.com/a/google.com/presentation/d/1uifwVYGNYTZDoGLyCb7sXa7g49mWNMW2gaWvMN5NLk8/edit#slide=id.p
 class MinorGCWrapperVisitor : public v8::PersistentHandleVisitor {
@@ -242,7 +302,7 @@ public:
             MutationObserver* observer = static_cast<MutationObserver*>(object);
             HashSet<Node*> observedNodes = observer->getObservedNodes();
             for (HashSet<Node*>::iterator it = observedNodes.begin(); it != observedNodes.end(); ++it) {
-                v8::UniqueId id(reinterpret_cast<intptr_t>(V8GCController::opaqueRootForGC(*it, m_isolate)));
+                v8::UniqueId id(reinterpret_cast<intptr_t>(m_opaqueRoots.opaqueRootForGC(*it, m_isolate)));
                 m_isolate->SetReferenceFromGroup(id, wrapper);
             }
         } else {
@@ -260,9 +320,10 @@ public:
 
             if (node->hasEventListeners())
                 addReferencesForNodeWithEventListeners(m_isolate, node, wrapper);
-            Node* root = V8GCController::opaqueRootForGC(node, m_isolate);
+            Node* root = m_opaqueRoots.opaqueRootForGC(node, m_isolate);
             m_isolate->SetObjectGroupId(wrapper, v8::UniqueId(reinterpret_cast<intptr_t>(root)));
-            if (m_constructRetainedObjectInfos)
+            // Wrappers of connected nodes mostly come in runs sharing the document as their root.
+            if (m_constructRetainedObjectInfos && (m_groupsWhichNeedRetainerInfo.isEmpty() || m_groupsWhichNeedRetainerInfo.last() != root))
                 m_groupsWhichNeedRetainerInfo.append(root);
         } else if (classId == v8DOMObjectClassId) {
             void* root = type->opaqueRootForGC(object, wrapper, m_isolate);
@@ -274,6 +335,9 @@ public:
 
     void notifyFinished()
     {
+        lastMajorGCOpaqueRootAncestorSteps = m_opaqueRoots.ancestorSteps();
+        TRACE_COUNTER1("v8", "GCPrologueOpaqueRootAncestorSteps", lastMajorGCOpaqueRootAncestorSteps);
+
         if (!m_constructRetainedObjectInfos)
             return;
         std::sort(m_groupsWhichNeedRetainerInfo.begin(), m_groupsWhichNeedRetainerInfo.end());
@@ -301,6 +365,7 @@ private:
     }
 
     v8::Isolate* m_isolate;
+    OpaqueRootCache m_opaqueRoots;
     Vector<Node*> m_groupsWhichNeedRetainerInfo;
     bool m_liveRootGroupIdSet;
     bool m_constructRetainedObjectInfos;
@@ -343,6 +408,11 @@ void V8GCController::majorGCPrologue(bool constructRetainedObjectInfos)
     V8PerIsolateData::from(isolate)->stringCache()->clearOnGC();
 }
 
+size_t V8GCController::lastMajorGCOpaqueRootAncestorStepsForTesting()
+{
+    return lastMajorGCOpaqueRootAncestorSteps;
+}
+
 static int workingSetEstimateMB = 0;
 
 static Mutex& workingSetEstimateMBMutex()
@@ -415,6 +485,15 @@ void V8GCController::hintForCollectGarbage()
     v8::V8::IdleNotification(longIdlePauseInMS);
 }
 
+void V8GCController::idleNotificationUntil(double deadline)
+{
+    int idleTimeInMS = static_cast<int>((deadline - monotonicallyIncreasingTime()) * 1000);
+    if (idleTimeInMS <= 0)
+        return;
+    TRACE_EVENT1("v8", "V8GCController::idleNotificationUntil", "idleTimeInMS", idleTimeInMS);
+    v8::V8::IdleNotificationInMs(idleTimeInMS);
+}
+
 void V8GCController::collectGarbage()
 {
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
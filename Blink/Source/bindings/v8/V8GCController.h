@@ -49,9 +49,15 @@ public:
 
     static void checkMemoryUsage();
     static void hintForCollectGarbage();
+    // Lets V8 do incremental GC work that ends before the given
+    // monotonicallyIncreasingTime() deadline, in seconds. V8 is told
+    // the time left in milliseconds.
+    static void idleNotificationUntil(double deadline);
     static void collectGarbage();
 
     static Node* opaqueRootForGC(Node*, v8::Isolate*);
+    // The number of ancestors the last major GC prologue walked to find the opaque roots of node wrappers.
+    static size_t lastMajorGCOpaqueRootAncestorStepsForTesting();
 };
 
 }
@@ -51,6 +51,8 @@ void V8PerContextData::dispose()
             wrapper.Clear();
         }
         m_wrapperBoilerplates.clear();
+        m_lastBoilerplateType = 0;
+        m_lastBoilerplate.Clear();
     }
 
     {
@@ -75,10 +75,18 @@ public:
     // To create JS Wrapper objects, we create a cache of a 'boiler plate'
     // object, and then simply Clone that object each time we need a new one.
     // This is faster than going through the full object creation process.
+    // Wrappers tend to be created in runs of the same type (e.g. the elements
+    // of a NodeList), so the last boilerplate used is checked before the map.
     v8::Local<v8::Object> createWrapperFromCache(WrapperTypeInfo* type)
     {
+        if (type == m_lastBoilerplateType)
+            return m_lastBoilerplate->Clone();
         v8::Persistent<v8::Object> boilerplate = m_wrapperBoilerplates.get(type);
-        return !boilerplate.IsEmpty() ? boilerplate->Clone() : createWrapperFromCacheSlowCase(type);
+        if (boilerplate.IsEmpty())
+            return createWrapperFromCacheSlowCase(type);
+        m_lastBoilerplateType = type;
+        m_lastBoilerplate = boilerplate;
+        return boilerplate->Clone();
     }
 
     v8::Local<v8::Function> constructorForType(WrapperTypeInfo* type)
@@ -106,7 +114,7 @@ public:
 
 private:
     explicit V8PerContextData(v8::Persistent<v8::Context> context)
-        : m_activityLogger(0), m_context(context)
+        : m_lastBoilerplateType(0), m_activityLogger(0), m_context(context)
     {
     }
 
@@ -119,6 +127,9 @@ private:
     // The boilerplate is used to create additional wrappers of the same type.
     typedef WTF::HashMap<WrapperTypeInfo*, v8::Persistent<v8::Object> > WrapperBoilerplateMap;
     WrapperBoilerplateMap m_wrapperBoilerplates;
+    // Not owned; aliases the entry of m_wrapperBoilerplates for m_lastBoilerplateType.
+    WrapperTypeInfo* m_lastBoilerplateType;
+    v8::Persistent<v8::Object> m_lastBoilerplate;
 
     typedef WTF::HashMap<WrapperTypeInfo*, v8::Persistent<v8::Function> > ConstructorMap;
     ConstructorMap m_constructorMap;
@@ -51,7 +51,7 @@ void WebCoreStringResourceBase::visitStrings(ExternalStringVisitor* visitor)
 
 template<class StringClass> struct StringTraits {
     static const StringClass& fromStringResource(WebCoreStringResourceBase*);
-    static bool is16BitAtomicString(StringClass&);
+    static WebCoreStringResource8* createOneByteResource(const StringClass&);
     template<bool oneByte>
     static StringClass fromV8String(v8::Handle<v8::String>, int);
 };
@@ -62,9 +62,9 @@ struct StringTraits<String> {
     {
         return resource->webcoreString();
     }
-    static bool is16BitAtomicString(String& string)
+    static WebCoreStringResource8* createOneByteResource(const String& string)
     {
-        return false;
+        return new WebCoreStringResource8(string);
     }
     template<bool oneByte>
     static String fromV8String(v8::Handle<v8::String>, int);
@@ -76,9 +76,13 @@ struct StringTraits<AtomicString> {
     {
         return resource->atomicString();
     }
-    static bool is16BitAtomicString(AtomicString& string)
+    static WebCoreStringResource8* createOneByteResource(const AtomicString& string)
     {
-        return !string.string().is8Bit();
+        // An equal 16-bit AtomicString may already exist. Sharing its buffer would widen the V8 string,
+        // so V8 gets a one-byte copy that is kept next to it.
+        if (!string.string().is8Bit())
+            return new WebCoreStringResource8(String::make8BitFrom16BitSource(string.string().characters16(), string.length()), string);
+        return new WebCoreStringResource8(string);
     }
     template<bool oneByte>
     static AtomicString fromV8String(v8::Handle<v8::String>, int);
@@ -160,19 +164,30 @@ StringType v8StringToWebCoreString(v8::Handle<v8::String> v8String, ExternalMode
 
     bool oneByte = v8String->IsOneByte();
     StringType result(oneByte ? StringTraits<StringType>::template fromV8String<true>(v8String, length) : StringTraits<StringType>::template fromV8String<false>(v8String, length));
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    StringCache* stringCache = V8PerIsolateData::from(isolate)->stringCache();
+    stringCache->didCopyV8String();
 
     if (external != Externalize || !v8String->CanMakeExternal())
         return result;
 
-    if (oneByte && !StringTraits<StringType>::is16BitAtomicString(result)) {
-        WebCoreStringResource8* stringResource = new WebCoreStringResource8(result);
-        if (UNLIKELY(!v8String->MakeExternal(stringResource)))
+    bool externalized;
+    if (oneByte) {
+        WebCoreStringResource8* stringResource = StringTraits<StringType>::createOneByteResource(result);
+        externalized = v8String->MakeExternal(stringResource);
+        if (UNLIKELY(!externalized))
             delete stringResource;
     } else {
         WebCoreStringResource16* stringResource = new WebCoreStringResource16(result);
-        if (UNLIKELY(!v8String->MakeExternal(stringResource)))
+        externalized = v8String->MakeExternal(stringResource);
+        if (UNLIKELY(!externalized))
             delete stringResource;
     }
+
+    // Let the StringCache hand out this V8 string when the WebCore string
+    // comes back to JavaScript.
+    if (LIKELY(externalized))
+        stringCache->didExternalizeV8String(result.impl(), v8String, isolate);
     return result;
 }
     
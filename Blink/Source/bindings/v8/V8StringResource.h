@@ -62,6 +62,20 @@ public:
         v8::V8::AdjustAmountOfExternalAllocatedMemory(memoryConsumption(string));
     }
 
+    // For a one-byte V8 string equal to a 16-bit AtomicString. V8 gets the 8-bit copy, and conversions
+    // back to an AtomicString find the existing one here.
+    WebCoreStringResourceBase(const String& string, const AtomicString& atomicString)
+        : m_plainString(string)
+        , m_atomicString(atomicString)
+    {
+#ifndef NDEBUG
+        m_threadId = WTF::currentThread();
+#endif
+        ASSERT(!string.isNull());
+        ASSERT(string == atomicString);
+        v8::V8::AdjustAmountOfExternalAllocatedMemory(memoryConsumption(string) + memoryConsumption(atomicString.string()));
+    }
+
     virtual ~WebCoreStringResourceBase()
     {
 #ifndef NDEBUG
@@ -127,6 +141,7 @@ class WebCoreStringResource8 : public WebCoreStringResourceBase, public v8::Stri
 public:
     explicit WebCoreStringResource8(const String& string) : WebCoreStringResourceBase(string) { }
     explicit WebCoreStringResource8(const AtomicString& string) : WebCoreStringResourceBase(string) { }
+    WebCoreStringResource8(const String& string, const AtomicString& atomicString) : WebCoreStringResourceBase(string, atomicString) { }
 
     virtual size_t length() const OVERRIDE { return m_plainString.impl()->length(); }
     virtual const char* data() const OVERRIDE
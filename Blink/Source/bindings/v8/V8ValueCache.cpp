@@ -28,6 +28,7 @@
 
 #include "bindings/v8/V8Binding.h"
 #include "core/dom/WebCoreMemoryInstrumentation.h"
+#include "core/platform/chromium/TraceEvent.h"
 #include "wtf/MemoryInstrumentationHashMap.h"
 
 namespace WTF {
@@ -82,6 +83,7 @@ v8::Handle<v8::String> StringCache::v8ExternalStringSlow(StringImpl* stringImpl,
 
     v8::Persistent<v8::String> cachedV8String = m_stringCache.get(stringImpl);
     if (cachedV8String.IsWeak(isolate)) {
+        ++m_hitCount;
         m_lastStringImpl = stringImpl;
         m_lastV8String = cachedV8String;
         if (handleType == ReturnUnsafeHandle)
@@ -89,6 +91,8 @@ v8::Handle<v8::String> StringCache::v8ExternalStringSlow(StringImpl* stringImpl,
         return v8::Local<v8::String>::New(cachedV8String);
     }
 
+    ++m_missCount;
+    TRACE_COUNTER2("v8", "StringCacheLookups", "hits", m_hitCount, "misses", m_missCount);
     v8::Local<v8::String> newString = makeExternalString(String(stringImpl));
     if (newString.IsEmpty())
         return newString;
@@ -97,6 +101,26 @@ v8::Handle<v8::String> StringCache::v8ExternalStringSlow(StringImpl* stringImpl,
     if (wrapper.IsEmpty())
         return newString;
 
+    setWeakV8String(stringImpl, wrapper, isolate);
+    return newString;
+}
+
+void StringCache::didExternalizeV8String(StringImpl* stringImpl, v8::Handle<v8::String> v8String, v8::Isolate* isolate)
+{
+    ++m_externalizedCount;
+    TRACE_COUNTER1("v8", "StringCacheExternalizedStrings", m_externalizedCount);
+    if (!stringImpl->length() || m_stringCache.contains(stringImpl))
+        return;
+
+    v8::Persistent<v8::String> wrapper(isolate, v8String);
+    if (wrapper.IsEmpty())
+        return;
+
+    setWeakV8String(stringImpl, wrapper, isolate);
+}
+
+void StringCache::setWeakV8String(StringImpl* stringImpl, v8::Persistent<v8::String> wrapper, v8::Isolate* isolate)
+{
     stringImpl->ref();
     wrapper.MarkIndependent(isolate);
     WeakHandleListener<StringCache, StringImpl>::makeWeak(isolate, wrapper, stringImpl);
@@ -104,13 +128,13 @@ v8::Handle<v8::String> StringCache::v8ExternalStringSlow(StringImpl* stringImpl,
 
     m_lastStringImpl = stringImpl;
     m_lastV8String = wrapper;
-
-    return newString;
 }
 
 void StringCache::reportMemoryUsage(MemoryObjectInfo* memoryObjectInfo) const
 {
     MemoryClassInfo info(memoryObjectInfo, this, WebCoreMemoryTypes::Binding);
+    memoryObjectInfo->setName(String::format("StringCache (hits: %zu, misses: %zu, copies: %zu, externalized: %zu)",
+        m_hitCount, m_missCount, m_copyCount, m_externalizedCount).utf8().data());
     info.addMember(m_stringCache, "stringCache");
     info.ignoreMember(m_lastV8String);
     info.addMember(m_lastStringImpl, "lastStringImpl");
@@ -44,13 +44,24 @@ enum ReturnHandleType {
     ReturnUnsafeHandle
 };
 
+// StringCache maps StringImpls to the V8 strings that share their buffer,
+// in both directions: strings created for WebCore strings are entered here,
+// and so are V8 strings that were externalized when converted to WebCore
+// strings. Passing the same string back and forth therefore never copies.
 class StringCache {
 public:
-    StringCache() { }
+    StringCache()
+        : m_hitCount(0)
+        , m_missCount(0)
+        , m_externalizedCount(0)
+        , m_copyCount(0)
+    {
+    }
 
     v8::Handle<v8::String> v8ExternalString(StringImpl* stringImpl, ReturnHandleType handleType, v8::Isolate* isolate)
     {
         if (m_lastStringImpl.get() == stringImpl && m_lastV8String.IsWeak(isolate)) {
+            ++m_hitCount;
             if (handleType == ReturnUnsafeHandle)
                 return m_lastV8String;
             return v8::Local<v8::String>::New(isolate, m_lastV8String);
@@ -68,8 +79,14 @@ public:
     void remove(StringImpl*);
     void reportMemoryUsage(MemoryObjectInfo*) const;
 
+    // Called when the characters of a V8 string were copied into a new StringImpl.
+    void didCopyV8String() { ++m_copyCount; }
+    // Called when a copied V8 string was externalized to share the buffer with its StringImpl.
+    void didExternalizeV8String(StringImpl*, v8::Handle<v8::String>, v8::Isolate*);
+
 private:
     v8::Handle<v8::String> v8ExternalStringSlow(StringImpl*, ReturnHandleType, v8::Isolate*);
+    void setWeakV8String(StringImpl*, v8::Persistent<v8::String>, v8::Isolate*);
 
     HashMap<StringImpl*, v8::Persistent<v8::String> > m_stringCache;
     v8::Persistent<v8::String> m_lastV8String;
@@ -77,6 +94,13 @@ private:
     // hence lastStringImpl might be not a key of the cache (in sense of identity)
     // and hence it's not refed on addition.
     RefPtr<StringImpl> m_lastStringImpl;
+
+    // Reported by reportMemoryUsage(). Hits and misses count lookups of V8 strings for WebCore strings,
+    // copies count V8 strings copied into WebCore strings, of which some were then externalized.
+    size_t m_hitCount;
+    size_t m_missCount;
+    size_t m_externalizedCount;
+    size_t m_copyCount;
 };
 
 const int numberOfCachedSmallIntegers = 64;
@@ -173,6 +173,7 @@
 #include "core/rendering/RenderArena.h"
 #include "core/rendering/RenderFullScreen.h"
 #include "core/rendering/RenderLayerCompositor.h"
+#include "core/rendering/RenderLazyBlock.h"
 #include "core/rendering/RenderNamedFlowThread.h"
 #include "core/rendering/RenderTextControl.h"
 #include "core/rendering/RenderView.h"
@@ -1767,6 +1768,17 @@ void Document::updateLayoutIgnorePendingStylesheets()
     m_ignorePendingStylesheets = oldIgnore;
 }
 
+void Document::updateLayoutIgnorePendingStylesheetsForNode(Node* node)
+{
+    updateLayoutIgnorePendingStylesheets();
+
+    RenderObject* renderer = node->renderer();
+    if (!renderer || !renderView() || !renderView()->firstLazyBlock())
+        return;
+    if (RenderLazyBlock::markSkippedAncestorsForLayout(renderer))
+        updateLayoutIgnorePendingStylesheets();
+}
+
 PassRefPtr<RenderStyle> Document::styleForElementIgnoringPendingStylesheets(Element* element)
 {
     ASSERT_ARG(element, element->document() == this);
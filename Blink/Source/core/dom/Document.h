@@ -487,6 +487,9 @@ public:
     void updateStyleIfNeeded();
     void updateLayout();
     void updateLayoutIgnorePendingStylesheets();
+    // Also lays out the part of a lazy block containing |node| if it was
+    // skipped for being offscreen, so geometry queries on it are accurate.
+    void updateLayoutIgnorePendingStylesheetsForNode(Node*);
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
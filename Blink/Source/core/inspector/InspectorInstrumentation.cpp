@@ -511,6 +511,18 @@ void didScrollLayerImpl(InstrumentingAgents* instrumentingAgents)
         timelineAgent->didScrollLayer();
 }
 
+void willComputeCompositingRequirementsImpl(InstrumentingAgents* instrumentingAgents, Frame* frame)
+{
+    if (InspectorTimelineAgent* timelineAgent = instrumentingAgents->inspectorTimelineAgent())
+        timelineAgent->willComputeCompositingRequirements(frame);
+}
+
+void didComputeCompositingRequirementsImpl(InstrumentingAgents* instrumentingAgents)
+{
+    if (InspectorTimelineAgent* timelineAgent = instrumentingAgents->inspectorTimelineAgent())
+        timelineAgent->didComputeCompositingRequirements();
+}
+
 InspectorInstrumentationCookie willRecalculateStyleImpl(InstrumentingAgents* instrumentingAgents, Document* document)
 {
     int timelineAgentId = 0;
@@ -78,6 +78,8 @@ InspectorInstrumentationCookie willDispatchXHRLoadEventImpl(InstrumentingAgents*
 void didDispatchXHRLoadEventImpl(const InspectorInstrumentationCookie&);
 void willScrollLayerImpl(InstrumentingAgents*, Frame*);
 void didScrollLayerImpl(InstrumentingAgents*);
+void willComputeCompositingRequirementsImpl(InstrumentingAgents*, Frame*);
+void didComputeCompositingRequirementsImpl(InstrumentingAgents*);
 void willPaintImpl(InstrumentingAgents*, RenderObject*);
 void didPaintImpl(InstrumentingAgents*, RenderObject*, GraphicsContext*, const LayoutRect&);
 InspectorInstrumentationCookie willRecalculateStyleImpl(InstrumentingAgents*, Document*);
@@ -453,6 +455,20 @@ inline void didScrollLayer(Frame* frame)
         didScrollLayerImpl(instrumentingAgents);
 }
 
+inline void willComputeCompositingRequirements(Frame* frame)
+{
+    FAST_RETURN_IF_NO_FRONTENDS(void());
+    if (InstrumentingAgents* instrumentingAgents = instrumentingAgentsForFrame(frame))
+        willComputeCompositingRequirementsImpl(instrumentingAgents, frame);
+}
+
+inline void didComputeCompositingRequirements(Frame* frame)
+{
+    FAST_RETURN_IF_NO_FRONTENDS(void());
+    if (InstrumentingAgents* instrumentingAgents = instrumentingAgentsForFrame(frame))
+        didComputeCompositingRequirementsImpl(instrumentingAgents);
+}
+
 inline void willPaint(RenderObject* renderer)
 {
     FAST_RETURN_IF_NO_FRONTENDS(void());
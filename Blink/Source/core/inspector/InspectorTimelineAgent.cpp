@@ -80,6 +80,7 @@ static const char Paint[] = "Paint";
 static const char ScrollLayer[] = "ScrollLayer";
 static const char ResizeImage[] = "ResizeImage";
 static const char CompositeLayers[] = "CompositeLayers";
+static const char ComputeCompositingRequirements[] = "ComputeCompositingRequirements";
 
 static const char ParseHTML[] = "ParseHTML";
 
@@ -378,6 +379,16 @@ void InspectorTimelineAgent::didScrollLayer()
     didCompleteCurrentRecord(TimelineRecordType::ScrollLayer);
 }
 
+void InspectorTimelineAgent::willComputeCompositingRequirements(Frame* frame)
+{
+    pushCurrentRecord(InspectorObject::create(), TimelineRecordType::ComputeCompositingRequirements, false, frame);
+}
+
+void InspectorTimelineAgent::didComputeCompositingRequirements()
+{
+    didCompleteCurrentRecord(TimelineRecordType::ComputeCompositingRequirements);
+}
+
 void InspectorTimelineAgent::willDecodeImage(const String& imageType)
 {
     pushCurrentRecord(TimelineRecordFactory::createDecodeImageData(imageType), TimelineRecordType::DecodeImage, true, 0);
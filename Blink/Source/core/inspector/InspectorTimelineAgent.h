@@ -147,6 +147,9 @@ public:
     void willScrollLayer(Frame*);
     void didScrollLayer();
 
+    void willComputeCompositingRequirements(Frame*);
+    void didComputeCompositingRequirements();
+
     void willComposite();
     void didComposite();
 
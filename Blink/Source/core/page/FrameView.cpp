@@ -1079,6 +1079,7 @@ void FrameView::layout(bool allowSubtree)
 
             endDeferredRepaints();
             m_inLayout = false;
+            RenderLayer::invalidateCachedGeometry();
 
             if (subtree)
                 root->view()->popLayoutState(root);
@@ -1635,6 +1636,9 @@ void FrameView::setViewportConstrainedObjectsNeedLayout()
 
 void FrameView::scrollPositionChanged()
 {
+    // Sticky positioned boxes move with the viewport.
+    RenderLayer::invalidateCachedGeometryForFrameScroll();
+
     frame()->eventHandler()->sendScrollEvent();
     frame()->eventHandler()->dispatchFakeMouseMoveEventSoon();
 
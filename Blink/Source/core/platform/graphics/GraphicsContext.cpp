@@ -41,6 +41,7 @@
 #include "third_party/skia/include/core/SkAnnotation.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 #include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/effects/SkBlurMaskFilter.h"
 #include "third_party/skia/include/effects/SkLayerDrawLooper.h"
 
@@ -63,6 +64,8 @@ GraphicsContext::GraphicsContext(SkCanvas* canvas)
     , m_accelerated(false)
     , m_isCertainlyOpaque(true)
     , m_printing(false)
+    , m_recordingPicture(0)
+    , m_recordingParentCanvas(0)
 {
     if (canvas) {
         m_data = adoptPtr(new PlatformContextSkia(canvas));
@@ -560,6 +563,42 @@ void GraphicsContext::endTransparencyLayer()
     --m_transparencyCount;
 }
 
+void GraphicsContext::beginRecording(SkPicture* picture, const IntSize& size)
+{
+    ASSERT(!m_recordingPicture);
+    if (paintingDisabled())
+        return;
+
+    // Fetching the canvas flushes pending saves, which must land on the canvas that will restore them.
+    m_recordingParentCanvas = platformContext()->canvas();
+    m_recordingPicture = picture;
+    platformContext()->setCanvas(picture->beginRecording(size.width(), size.height(), SkPicture::kOptimizeForClippedPlayback_RecordingFlag));
+}
+
+void GraphicsContext::endRecording()
+{
+    if (paintingDisabled())
+        return;
+
+    ASSERT(m_recordingPicture);
+    m_recordingPicture->endRecording();
+    platformContext()->setCanvas(m_recordingParentCanvas);
+    m_recordingPicture = 0;
+    m_recordingParentCanvas = 0;
+}
+
+void GraphicsContext::drawPicture(SkPicture* picture, const IntPoint& point)
+{
+    if (paintingDisabled())
+        return;
+
+    SkCanvas* canvas = platformContext()->canvas();
+    canvas->save(SkCanvas::kMatrix_SaveFlag);
+    canvas->translate(point.x(), point.y());
+    canvas->drawPicture(*picture);
+    canvas->restore();
+}
+
 void GraphicsContext::beginLayerClippedToImage(const FloatRect& rect, const ImageBuffer* imageBuffer)
 {
     SkRect bounds = WebCoreFloatRectToSKRect(rect);
@@ -49,6 +49,8 @@
 #include <wtf/Noncopyable.h>
 #include <wtf/PassOwnPtr.h>
 
+class SkPicture;
+
 namespace WebCore {
 class PlatformContextSkia;
 }
@@ -225,6 +227,7 @@ namespace WebCore {
         // The opaque region is empty until tracking is turned on.
         // It is never clerared by the context.
         void setTrackOpaqueRegion(bool track) { m_trackOpaqueRegion = track; }
+        bool isTrackingOpaqueRegion() const { return m_trackOpaqueRegion; }
         const OpaqueRegionSkia& opaqueRegion() const { return m_opaqueRegion; }
 
         void setImageInterpolationQuality(InterpolationQuality);
@@ -335,6 +338,13 @@ namespace WebCore {
         void beginTransparencyLayer(float opacity);
         void endTransparencyLayer();
         bool isInTransparencyLayer() const;
+
+        // Redirects drawing into |picture|, with its origin at (0, 0) of the current coordinate
+        // space, until endRecording(). Drawing outside |size| is dropped. Recordings don't nest.
+        void beginRecording(SkPicture*, const IntSize&);
+        void endRecording();
+        bool isRecording() const { return m_recordingPicture; }
+        void drawPicture(SkPicture*, const IntPoint&);
         // Begins a layer that is clipped to the image |imageBuffer| at the location
         // |rect|. This layer is implicitly restored when the next restore is invoked.
         // NOTE: |imageBuffer| may be deleted before the |restore| is invoked.
@@ -452,6 +462,10 @@ namespace WebCore {
         bool m_accelerated;
         bool m_isCertainlyOpaque;
         bool m_printing;
+
+        // See beginRecording().
+        SkPicture* m_recordingPicture;
+        SkCanvas* m_recordingParentCanvas;
     };
 } // namespace WebCore
 
@@ -79,14 +79,19 @@ void ImageFrameGenerator::copyData(RefPtr<SharedBuffer>* data, bool* allDataRece
 
 const ScaledImageFragment* ImageFrameGenerator::decodeAndScale(const SkISize& scaledSize)
 {
+    // Complete cache entries are never overwritten, so they can be used without
+    // waiting for a decode or scale of this image on another thread.
+    const ScaledImageFragment* cachedImage = tryToLockCompleteCache(scaledSize);
+    if (cachedImage)
+        return cachedImage;
+
     // Prevents concurrent decode or scale operations on the same image data.
     // Multiple LazyDecodingPixelRefs can call this method at the same time.
     MutexLocker lock(m_decodeMutex);
     if (m_decodeFailedAndEmpty)
         return 0;
 
-    const ScaledImageFragment* cachedImage = 0;
-
+    // Another thread may have completed the cache entry while we were waiting.
     cachedImage = tryToLockCompleteCache(scaledSize);
     if (cachedImage)
         return cachedImage;
@@ -75,8 +75,10 @@ public:
     bool hasAlpha();
 
 private:
-    // These methods are called while m_decodeMutex is locked.
+    // Can be called without m_decodeMutex locked.
     const ScaledImageFragment* tryToLockCompleteCache(const SkISize& scaledSize);
+
+    // These methods are called while m_decodeMutex is locked.
     const ScaledImageFragment* tryToScale(const ScaledImageFragment* fullSizeImage, const SkISize& scaledSize);
     const ScaledImageFragment* tryToResumeDecodeAndScale(const SkISize& scaledSize);
     const ScaledImageFragment* tryToDecodeAndScale(const SkISize& scaledSize);
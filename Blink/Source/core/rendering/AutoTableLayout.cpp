@@ -25,6 +25,7 @@
 #include "core/rendering/RenderTable.h"
 #include "core/rendering/RenderTableCell.h"
 #include "core/rendering/RenderTableCol.h"
+#include "core/rendering/RenderTableRow.h"
 #include "core/rendering/RenderTableSection.h"
 
 using namespace std;
@@ -33,6 +34,10 @@ namespace WebCore {
 
 AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
+    , m_lastRecalcedSection(0)
+    , m_recalcedRowsBeforeLastSection(0)
+    , m_recalcedRowsInLastSection(0)
+    , m_recalcedCellsInLastRow(0)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
 {
@@ -44,102 +49,156 @@ AutoTableLayout::~AutoTableLayout()
 
 void AutoTableLayout::recalcColumn(unsigned effCol)
 {
-    Layout& columnLayout = m_layoutStruct[effCol];
-
-    RenderTableCell* fixedContributor = 0;
-    RenderTableCell* maxContributor = 0;
-
     for (RenderObject* child = m_table->children()->firstChild(); child; child = child->nextSibling()) {
         if (child->isRenderTableCol()){
             // RenderTableCols don't have the concept of preferred logical width, but we need to clear their dirty bits
             // so that if we call setPreferredWidthsDirty(true) on a col or one of its descendants, we'll mark it's
             // ancestors as dirty.
             toRenderTableCol(child)->clearPreferredLogicalWidthsDirtyBits();
-        } else if (child->isTableSection()) {
-            RenderTableSection* section = toRenderTableSection(child);
-            unsigned numRows = section->numRows();
-            for (unsigned i = 0; i < numRows; i++) {
-                RenderTableSection::CellStruct current = section->cellAt(i, effCol);
-                RenderTableCell* cell = current.primaryCell();
-                
-                if (current.inColSpan || !cell)
-                    continue;
-
-                bool cellHasContent = cell->children()->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
-                if (cellHasContent)
-                    columnLayout.emptyCellsOnly = false;
-
-                // A cell originates in this column. Ensure we have
-                // a min/max width of at least 1px for this column now.
-                columnLayout.minLogicalWidth = max<int>(columnLayout.minLogicalWidth, cellHasContent ? 1 : 0);
-                columnLayout.maxLogicalWidth = max<int>(columnLayout.maxLogicalWidth, 1);
-
-                if (cell->colSpan() == 1) {
-                    columnLayout.minLogicalWidth = max<int>(cell->minPreferredLogicalWidth(), columnLayout.minLogicalWidth);
-                    if (cell->maxPreferredLogicalWidth() > columnLayout.maxLogicalWidth) {
-                        columnLayout.maxLogicalWidth = cell->maxPreferredLogicalWidth();
-                        maxContributor = cell;
-                    }
+        } else if (child->isTableSection())
+            addColumnCells(effCol, toRenderTableSection(child), 0);
+    }
+
+    updateColumnLayout(effCol);
+}
 
-                    // All browsers implement a size limit on the cell's max width. 
-                    // Our limit is based on KHTML's representation that used 16 bits widths.
-                    // FIXME: Other browsers have a lower limit for the cell's max width. 
-                    const int cCellMaxWidth = 32760;
-                    Length cellLogicalWidth = cell->styleOrColLogicalWidth();
-                    if (cellLogicalWidth.value() > cCellMaxWidth)
-                        cellLogicalWidth.setValue(cCellMaxWidth);
-                    if (cellLogicalWidth.isNegative())
-                        cellLogicalWidth.setValue(0);
-                    switch (cellLogicalWidth.type()) {
-                    case Fixed:
-                        // ignore width=0
-                        if (cellLogicalWidth.isPositive() && !columnLayout.logicalWidth.isPercent()) {
-                            int logicalWidth = cell->adjustBorderBoxLogicalWidthForBoxSizing(cellLogicalWidth.value());
-                            if (columnLayout.logicalWidth.isFixed()) {
-                                // Nav/IE weirdness
-                                if ((logicalWidth > columnLayout.logicalWidth.value()) 
-                                    || ((columnLayout.logicalWidth.value() == logicalWidth) && (maxContributor == cell))) {
-                                    columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
-                                    fixedContributor = cell;
-                                }
-                            } else {
-                                columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
-                                fixedContributor = cell;
-                            }
+void AutoTableLayout::addColumnCells(unsigned effCol, RenderTableSection* section, unsigned firstRow)
+{
+    ColumnCells& columnCells = m_columnCells[effCol];
+    Layout& columnLayout = columnCells.layout;
+    RenderTableCell*& fixedContributor = columnCells.fixedContributor;
+    RenderTableCell*& maxContributor = columnCells.maxContributor;
+
+    unsigned numRows = section->numRows();
+    for (unsigned i = firstRow; i < numRows; i++) {
+        RenderTableSection::CellStruct current = section->cellAt(i, effCol);
+        RenderTableCell* cell = current.primaryCell();
+        
+        if (current.inColSpan || !cell)
+            continue;
+
+        bool cellHasContent = cell->children()->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
+        if (cellHasContent)
+            columnLayout.emptyCellsOnly = false;
+
+        // A cell originates in this column. Ensure we have
+        // a min/max width of at least 1px for this column now.
+        columnLayout.minLogicalWidth = max<int>(columnLayout.minLogicalWidth, cellHasContent ? 1 : 0);
+        columnLayout.maxLogicalWidth = max<int>(columnLayout.maxLogicalWidth, 1);
+
+        if (cell->colSpan() == 1) {
+            columnLayout.minLogicalWidth = max<int>(cell->minPreferredLogicalWidth(), columnLayout.minLogicalWidth);
+            if (cell->maxPreferredLogicalWidth() > columnLayout.maxLogicalWidth) {
+                columnLayout.maxLogicalWidth = cell->maxPreferredLogicalWidth();
+                maxContributor = cell;
+            }
+
+            // All browsers implement a size limit on the cell's max width. 
+            // Our limit is based on KHTML's representation that used 16 bits widths.
+            // FIXME: Other browsers have a lower limit for the cell's max width. 
+            const int cCellMaxWidth = 32760;
+            Length cellLogicalWidth = cell->styleOrColLogicalWidth();
+            if (cellLogicalWidth.value() > cCellMaxWidth)
+                cellLogicalWidth.setValue(cCellMaxWidth);
+            if (cellLogicalWidth.isNegative())
+                cellLogicalWidth.setValue(0);
+            switch (cellLogicalWidth.type()) {
+            case Fixed:
+                // ignore width=0
+                if (cellLogicalWidth.isPositive() && !columnLayout.logicalWidth.isPercent()) {
+                    int logicalWidth = cell->adjustBorderBoxLogicalWidthForBoxSizing(cellLogicalWidth.value());
+                    if (columnLayout.logicalWidth.isFixed()) {
+                        // Nav/IE weirdness
+                        if ((logicalWidth > columnLayout.logicalWidth.value()) 
+                            || ((columnLayout.logicalWidth.value() == logicalWidth) && (maxContributor == cell))) {
+                            columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
+                            fixedContributor = cell;
                         }
-                        break;
-                    case Percent:
-                        m_hasPercent = true;
-                        if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
-                            columnLayout.logicalWidth = cellLogicalWidth;
-                        break;
-                    case Relative:
-                        // FIXME: Need to understand this case and whether it makes sense to compare values
-                        // which are not necessarily of the same type.
-                        if (cellLogicalWidth.value() > columnLayout.logicalWidth.value())
-                            columnLayout.logicalWidth = cellLogicalWidth;
-                    default:
-                        break;
+                    } else {
+                        columnLayout.logicalWidth.setValue(Fixed, logicalWidth);
+                        fixedContributor = cell;
                     }
-                } else if (!effCol || section->primaryCellAt(i, effCol - 1) != cell) {
-                    // This spanning cell originates in this column. Insert the cell into spanning cells list.
-                    insertSpanCell(cell);
                 }
+                break;
+            case Percent:
+                m_hasPercent = true;
+                if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
+                    columnLayout.logicalWidth = cellLogicalWidth;
+                break;
+            case Relative:
+                // FIXME: Need to understand this case and whether it makes sense to compare values
+                // which are not necessarily of the same type.
+                if (cellLogicalWidth.value() > columnLayout.logicalWidth.value())
+                    columnLayout.logicalWidth = cellLogicalWidth;
+            default:
+                break;
             }
+        } else if (!effCol || section->primaryCellAt(i, effCol - 1) != cell) {
+            // This spanning cell originates in this column. Insert the cell into spanning cells list.
+            insertSpanCell(cell);
         }
     }
+}
+
+void AutoTableLayout::updateColumnLayout(unsigned effCol)
+{
+    const ColumnCells& columnCells = m_columnCells[effCol];
+    Layout& columnLayout = m_layoutStruct[effCol];
+    columnLayout = columnCells.layout;
 
     // Nav/IE weirdness
     if (columnLayout.logicalWidth.isFixed()) {
-        if (m_table->document()->inQuirksMode() && columnLayout.maxLogicalWidth > columnLayout.logicalWidth.value() && fixedContributor != maxContributor) {
+        if (m_table->document()->inQuirksMode() && columnLayout.maxLogicalWidth > columnLayout.logicalWidth.value() && columnCells.fixedContributor != columnCells.maxContributor)
             columnLayout.logicalWidth = Length();
-            fixedContributor = 0;
-        }
     }
 
     columnLayout.maxLogicalWidth = max(columnLayout.maxLogicalWidth, columnLayout.minLogicalWidth);
 }
 
+static RenderTableSection* lastSection(RenderTable* table)
+{
+    for (RenderObject* child = table->lastChild(); child; child = child->previousSibling()) {
+        if (child->isTableSection())
+            return toRenderTableSection(child);
+    }
+    return 0;
+}
+
+static unsigned numCellsInRow(RenderTableSection* section, unsigned row)
+{
+    unsigned cells = 0;
+    for (RenderObject* child = section->rowRendererAt(row)->firstChild(); child; child = child->nextSibling()) {
+        if (child->isTableCell())
+            ++cells;
+    }
+    return cells;
+}
+
+void AutoTableLayout::rememberRecalcedRows()
+{
+    m_table->clearCellPreferredLogicalWidthsChanged();
+
+    m_lastRecalcedSection = lastSection(m_table);
+    m_recalcedRowsBeforeLastSection = 0;
+    for (RenderObject* child = m_table->firstChild(); child != m_lastRecalcedSection; child = child->nextSibling()) {
+        if (child->isTableSection())
+            m_recalcedRowsBeforeLastSection += toRenderTableSection(child)->numRows();
+    }
+
+    if (!m_lastRecalcedSection)
+        return;
+
+    // Rows created for a row-spanning cell have no renderer yet and get their cells later. They would
+    // have to be measured again, so leave the next recalc to fullRecalc().
+    unsigned numRows = m_lastRecalcedSection->numRows();
+    if (numRows && !m_lastRecalcedSection->rowRendererAt(numRows - 1)) {
+        m_lastRecalcedSection = 0;
+        return;
+    }
+    m_recalcedRowsInLastSection = numRows;
+    m_recalcedCellsInLastRow = numRows ? numCellsInRow(m_lastRecalcedSection, numRows - 1) : 0;
+}
+
 void AutoTableLayout::fullRecalc()
 {
     m_hasPercent = false;
@@ -147,7 +206,8 @@ void AutoTableLayout::fullRecalc()
 
     unsigned nEffCols = m_table->numEffCols();
     m_layoutStruct.resize(nEffCols);
-    m_layoutStruct.fill(Layout());
+    m_columnCells.resize(nEffCols);
+    m_columnCells.fill(ColumnCells());
     m_spanCells.fill(0);
 
     Length groupLogicalWidth;
@@ -164,9 +224,10 @@ void AutoTableLayout::fullRecalc()
             unsigned effCol = m_table->colToEffCol(currentColumn);
             unsigned span = column->span();
             if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1) {
-                m_layoutStruct[effCol].logicalWidth = colLogicalWidth;
-                if (colLogicalWidth.isFixed() && m_layoutStruct[effCol].maxLogicalWidth < colLogicalWidth.value())
-                    m_layoutStruct[effCol].maxLogicalWidth = colLogicalWidth.value();
+                Layout& columnLayout = m_columnCells[effCol].layout;
+                columnLayout.logicalWidth = colLogicalWidth;
+                if (colLogicalWidth.isFixed() && columnLayout.maxLogicalWidth < colLogicalWidth.value())
+                    columnLayout.maxLogicalWidth = colLogicalWidth.value();
             }
             currentColumn += span;
         }
@@ -178,6 +239,55 @@ void AutoTableLayout::fullRecalc()
 
     for (unsigned i = 0; i < nEffCols; i++)
         recalcColumn(i);
+
+    rememberRecalcedRows();
+}
+
+bool AutoTableLayout::recalcAppendedRows()
+{
+    // Data tables tend to grow by appending rows, which would otherwise make every preferred logical
+    // width computation walk all the cells again. As long as no cell that was already measured changed
+    // and the grid was not rebuilt, fold only the appended rows into the cached column cells.
+    RenderTableSection* section = m_lastRecalcedSection;
+    if (!section || m_table->cellPreferredLogicalWidthsChanged() || m_table->firstColumn() || lastSection(m_table) != section)
+        return false;
+
+    unsigned nEffCols = m_table->numEffCols();
+    if (nEffCols != m_columnCells.size())
+        return false;
+
+    unsigned rowsBeforeLastSection = 0;
+    for (RenderObject* child = m_table->firstChild(); child != section; child = child->nextSibling()) {
+        if (child->isTableSection())
+            rowsBeforeLastSection += toRenderTableSection(child)->numRows();
+    }
+    if (rowsBeforeLastSection != m_recalcedRowsBeforeLastSection)
+        return false;
+
+    unsigned firstRow = m_recalcedRowsInLastSection;
+    unsigned numRows = section->numRows();
+    if (numRows < firstRow || (firstRow && numCellsInRow(section, firstRow - 1) != m_recalcedCellsInLastRow))
+        return false;
+
+    // Spanning cells are kept sorted in the order fullRecalc() finds them, which appending cannot reproduce.
+    for (unsigned row = firstRow; row < numRows; ++row) {
+        RenderTableRow* rowRenderer = section->rowRendererAt(row);
+        if (!rowRenderer)
+            continue;
+        for (RenderObject* child = rowRenderer->firstChild(); child; child = child->nextSibling()) {
+            if (child->isTableCell() && toRenderTableCell(child)->colSpan() != 1)
+                return false;
+        }
+    }
+
+    m_effectiveLogicalWidthDirty = true;
+    for (unsigned i = 0; i < nEffCols; i++) {
+        addColumnCells(i, section, firstRow);
+        updateColumnLayout(i);
+    }
+
+    rememberRecalcedRows();
+    return true;
 }
 
 // FIXME: This needs to be adapted for vertical writing modes.
@@ -212,7 +322,8 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computeIntrinsicLogicalWidths(LayoutUnit& minWidth, LayoutUnit& maxWidth)
 {
-    fullRecalc();
+    if (!recalcAppendedRows())
+        fullRecalc();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
@@ -30,6 +30,7 @@ namespace WebCore {
 
 class RenderTable;
 class RenderTableCell;
+class RenderTableSection;
 
 class AutoTableLayout : public TableLayout {
 public:
@@ -42,7 +43,11 @@ public:
 
 private:
     void fullRecalc();
+    bool recalcAppendedRows();
+    void rememberRecalcedRows();
     void recalcColumn(unsigned effCol);
+    void addColumnCells(unsigned effCol, RenderTableSection*, unsigned firstRow);
+    void updateColumnLayout(unsigned effCol);
 
     int calcEffectiveLogicalWidth();
 
@@ -69,8 +74,26 @@ private:
         bool emptyCellsOnly;
     };
 
+    // What the cells of a column contribute, before the quirks applied by updateColumnLayout().
+    struct ColumnCells {
+        ColumnCells()
+            : fixedContributor(0)
+            , maxContributor(0)
+        {
+        }
+
+        Layout layout;
+        RenderTableCell* fixedContributor;
+        RenderTableCell* maxContributor;
+    };
+
     Vector<Layout, 4> m_layoutStruct;
+    Vector<ColumnCells, 4> m_columnCells;
     Vector<RenderTableCell*, 4> m_spanCells;
+    RenderTableSection* m_lastRecalcedSection;
+    unsigned m_recalcedRowsBeforeLastSection;
+    unsigned m_recalcedRowsInLastSection;
+    unsigned m_recalcedCellsInLastRow;
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
 };
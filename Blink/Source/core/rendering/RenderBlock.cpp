@@ -119,6 +119,34 @@ typedef WTF::HashSet<RenderBlock*> DelayedUpdateScrollInfoSet;
 static int gDelayUpdateScrollInfo = 0;
 static DelayedUpdateScrollInfoSet* gDelayedUpdateScrollInfoSet = 0;
 
+// Blocks with many block children keep an index of the vertical bands each child can be hit in, so that
+// hit testing only asks the children near the hit test location. Children that nodeAtPoint() does not
+// reject by their visual overflow rect, or that cover too many bands, are on a list that is always tested.
+struct ChildHitTestIndex {
+    WTF_MAKE_NONCOPYABLE(ChildHitTestIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ChildHitTestIndex()
+        : usable(false)
+        , firstBand(0)
+    {
+    }
+
+    bool usable;
+    Vector<RenderBox*> children;
+    // Indices into children, in ascending order.
+    Vector<unsigned> alwaysTested;
+    int firstBand;
+    Vector<Vector<unsigned> > bands;
+};
+
+typedef WTF::HashMap<const RenderBlock*, OwnPtr<ChildHitTestIndex> > ChildHitTestIndexMap;
+static ChildHitTestIndexMap* gChildHitTestIndexMap = 0;
+
+static const unsigned minimumChildrenForHitTestIndex = 32;
+static const int hitTestIndexBandShift = 8;
+static const int maximumHitTestIndexBandsPerChild = 16;
+static const int maximumHitTestIndexBands = 4096;
+
 static bool gColumnFlowSplitEnabled = true;
 
 bool RenderBlock::s_canPropagateFloatIntoSibling = false;
@@ -299,6 +327,8 @@ void RenderBlock::willBeDestroyed()
     if (UNLIKELY(gDelayedUpdateScrollInfoSet != 0))
         gDelayedUpdateScrollInfoSet->remove(this);
 
+    invalidateChildHitTestIndex();
+
     RenderBox::willBeDestroyed();
 }
 
@@ -1501,6 +1531,8 @@ void RenderBlock::layoutBlock(bool relayoutChildren, LayoutUnit pageLogicalHeigh
 {
     ASSERT(needsLayout());
 
+    invalidateChildHitTestIndex();
+
     if (isInline() && !isInlineBlockOrInlineTable()) // Inline <form>s inside various table elements can
         return;                                      // cause us to come in here.  Just bail.
 
@@ -5053,6 +5085,119 @@ void RenderBlock::adjustForColumnRect(LayoutSize& offset, const LayoutPoint& loc
     }
 }
 
+void RenderBlock::invalidateChildHitTestIndex()
+{
+    if (UNLIKELY(gChildHitTestIndexMap != 0))
+        gChildHitTestIndexMap->remove(this);
+}
+
+static inline bool childRejectsHitTestsOutsideVisualOverflow(const RenderBox* child)
+{
+    // RenderBlock::nodeAtPoint() returns early when the location misses the visual overflow rect,
+    // and every block subclass but these calls it before doing anything else.
+    return child->isRenderBlock() && !child->isTable() && !child->isRenderRegion() && !child->isRenderFlowThread();
+}
+
+static PassOwnPtr<ChildHitTestIndex> createChildHitTestIndex(RenderBlock* block)
+{
+    OwnPtr<ChildHitTestIndex> index = adoptPtr(new ChildHitTestIndex);
+
+    Vector<IntRect> childRects;
+    int firstBand = INT_MAX;
+    int lastBand = INT_MIN;
+    for (RenderBox* child = block->firstChildBox(); child; child = child->nextSiblingBox()) {
+        if (child->hasSelfPaintingLayer() || child->isFloating())
+            continue;
+        index->children.append(child);
+
+        IntRect childRect;
+        if (childRejectsHitTestsOutsideVisualOverflow(child)) {
+            LayoutRect overflowBox = child->visualOverflowRect();
+            child->flipForWritingMode(overflowBox);
+            overflowBox.moveBy(child->location());
+            childRect = enclosingIntRect(overflowBox);
+        }
+        if (childRect.isEmpty() || ((childRect.maxY() - 1) >> hitTestIndexBandShift) - (childRect.y() >> hitTestIndexBandShift) >= maximumHitTestIndexBandsPerChild) {
+            index->alwaysTested.append(index->children.size() - 1);
+            childRect = IntRect();
+        } else {
+            firstBand = min(firstBand, childRect.y() >> hitTestIndexBandShift);
+            lastBand = max(lastBand, (childRect.maxY() - 1) >> hitTestIndexBandShift);
+        }
+        childRects.append(childRect);
+    }
+
+    if (index->children.size() < minimumChildrenForHitTestIndex || index->alwaysTested.size() * 2 > index->children.size()
+        || lastBand - firstBand >= maximumHitTestIndexBands)
+        return index.release();
+
+    index->usable = true;
+    index->firstBand = firstBand;
+    index->bands.resize(lastBand - firstBand + 1);
+    for (unsigned i = 0; i < index->children.size(); ++i) {
+        const IntRect& childRect = childRects[i];
+        if (childRect.isEmpty())
+            continue;
+        int childLastBand = (childRect.maxY() - 1) >> hitTestIndexBandShift;
+        for (int band = childRect.y() >> hitTestIndexBandShift; band <= childLastBand; ++band)
+            index->bands[band - firstBand].append(i);
+    }
+    return index.release();
+}
+
+// Fills candidates with the children that may be hit at the location, last child first, and returns false
+// if the children have to be walked instead.
+static bool childHitTestCandidates(RenderBlock* block, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, Vector<RenderBox*, 16>& candidates)
+{
+    if (block->hasColumns() || block->style()->isFlippedBlocksWritingMode())
+        return false;
+
+    // Children move during layout, and may already have been moved or removed if layout is pending.
+    RenderView* view = block->view();
+    FrameView* frameView = view ? view->frameView() : 0;
+    if (!frameView || frameView->isInLayout() || frameView->needsLayout())
+        return false;
+
+    // Blocks with few children never get an index, so don't bother building one to find out.
+    unsigned childCount = 0;
+    for (RenderBox* child = block->firstChildBox(); child && childCount < minimumChildrenForHitTestIndex; child = child->nextSiblingBox())
+        ++childCount;
+    if (childCount < minimumChildrenForHitTestIndex)
+        return false;
+
+    if (!gChildHitTestIndexMap)
+        gChildHitTestIndexMap = new ChildHitTestIndexMap;
+
+    // The index stays valid until the block lays out again or its children change, see invalidateChildHitTestIndex().
+    ChildHitTestIndex* index = gChildHitTestIndexMap->get(block);
+    if (!index) {
+        OwnPtr<ChildHitTestIndex> newIndex = createChildHitTestIndex(block);
+        index = newIndex.get();
+        gChildHitTestIndexMap->set(block, newIndex.release());
+    }
+    if (!index->usable)
+        return false;
+
+    LayoutRect hitTestArea = locationInContainer.boundingBox();
+    hitTestArea.moveBy(-accumulatedOffset);
+    IntRect hitTestRect = enclosingIntRect(hitTestArea);
+    int firstBand = max(hitTestRect.y() >> hitTestIndexBandShift, index->firstBand);
+    int lastBand = min((hitTestRect.maxY() - 1) >> hitTestIndexBandShift, index->firstBand + static_cast<int>(index->bands.size()) - 1);
+
+    Vector<unsigned, 16> childIndices;
+    childIndices.append(index->alwaysTested);
+    for (int band = firstBand; band <= lastBand; ++band)
+        childIndices.append(index->bands[band - index->firstBand]);
+    std::sort(childIndices.begin(), childIndices.end());
+
+    for (size_t i = childIndices.size(); i; --i) {
+        if (i < childIndices.size() && childIndices[i - 1] == childIndices[i])
+            continue;
+        candidates.append(index->children[childIndices[i - 1]]);
+    }
+    return true;
+}
+
 bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset, HitTestAction hitTestAction)
 {
     if (childrenInline() && !isTable()) {
@@ -5064,6 +5209,16 @@ bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult&
         HitTestAction childHitTest = hitTestAction;
         if (hitTestAction == HitTestChildBlockBackgrounds)
             childHitTest = HitTestChildBlockBackground;
+        Vector<RenderBox*, 16> candidates;
+        if (childHitTestCandidates(this, locationInContainer, accumulatedOffset, candidates)) {
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                RenderBox* child = candidates[i];
+                LayoutPoint childPoint = flipForWritingModeForChild(child, accumulatedOffset);
+                if (child->nodeAtPoint(request, result, locationInContainer, childPoint, childHitTest))
+                    return true;
+            }
+            return false;
+        }
         for (RenderBox* child = lastChildBox(); child; child = child->previousSiblingBox()) {
             LayoutPoint childPoint = flipForWritingModeForChild(child, accumulatedOffset);
             if (!child->hasSelfPaintingLayer() && !child->isFloating() && child->nodeAtPoint(request, result, locationInContainer, childPoint, childHitTest))
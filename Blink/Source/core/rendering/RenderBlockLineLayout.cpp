@@ -1863,6 +1863,63 @@ void RenderBlock::repaintDirtyFloats(Vector<FloatWithRect>& floats)
     }
 }
 
+bool RenderBlock::lineBoxesSurviveLogicalWidthChange() const
+{
+    // determineStartPosition() lays the last line out again unless it ends in a forced break, so only that
+    // line may depend on the available width. Every line it keeps has to be start-aligned, end in a forced
+    // break, and still fit, and nothing on any line may be sized against our width.
+    RootInlineBox* lastLine = lastRootBox();
+    if (!firstRootBox() || !lastLine || isSVGText() || containsFloats() || hasColumns() || flowThreadContainingBlock() || exclusionShapeInsideInfo())
+        return false;
+
+    LayoutState* layoutState = view()->layoutState();
+    if (layoutState && (layoutState->isPaginated() || layoutState->lineGrid()))
+        return false;
+
+    RenderStyle* styleToUse = style();
+    if (!styleToUse->isLeftToRightDirection() || styleToUse->unicodeBidi() == Plaintext || !styleToUse->textIndent().isZero())
+        return false;
+    ETextAlign textAlign = styleToUse->textAlign();
+    if (textAlign != TASTART && textAlign != LEFT && textAlign != WEBKIT_LEFT)
+        return false;
+    TextAlignLast textAlignLast = styleToUse->textAlignLast();
+    if (textAlignLast != TextAlignLastAuto && textAlignLast != TextAlignLastStart && textAlignLast != TextAlignLastLeft)
+        return false;
+    if (styleToUse->textOverflow() || (isAnonymousBlock() && parent() && parent()->style()->textOverflow()))
+        return false;
+
+    bool autoWrap = false;
+    for (RenderObject* o = firstChild(); o; o = o->nextInPreOrder(this)) {
+        if (o->selfNeedsLayout())
+            return false;
+        if (o->isText()) {
+            autoWrap |= o->style()->autoWrap();
+            continue;
+        }
+        if (!o->isRenderInline())
+            return false;
+        RenderStyle* inlineStyle = o->style();
+        if (inlineStyle->marginStart().isPercent() || inlineStyle->marginEnd().isPercent() || inlineStyle->paddingStart().isPercent() || inlineStyle->paddingEnd().isPercent())
+            return false;
+    }
+
+    // A change to our border or padding moves the lines even though their breaks stay the same.
+    if (firstRootBox()->lineTopWithLeading() != borderBefore() + paddingBefore())
+        return false;
+
+    LayoutUnit lineLeft = logicalLeftOffsetForContent();
+    LayoutUnit lineRight = logicalRightOffsetForContent();
+    for (RootInlineBox* line = firstRootBox(); line; line = line->nextRootBox()) {
+        if (line == lastLine && !line->endsWithBreak())
+            break;
+        if (line->isDirty() || !line->endsWithBreak() || LayoutUnit(line->logicalLeft()) != lineLeft)
+            return false;
+        if (autoWrap && line->logicalRight() > lineRight)
+            return false;
+    }
+    return true;
+}
+
 void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repaintLogicalTop, LayoutUnit& repaintLogicalBottom)
 {
     setLogicalHeight(borderBefore() + paddingBefore());
@@ -1875,8 +1932,11 @@ void RenderBlock::layoutInlineChildren(bool relayoutChildren, LayoutUnit& repain
     bool clearLinesForPagination = firstLineBox() && flowThread && !flowThread->hasRegions();
 
     // Figure out if we should clear out our line boxes.
-    // FIXME: Handle resize eventually!
     bool isFullLayout = !firstLineBox() || selfNeedsLayout() || relayoutChildren || clearLinesForPagination;
+    // A change of our logical width alone does not invalidate lines that are ended by forced
+    // breaks and still fit, so keep them and let the partial layout path redo the last line.
+    if (isFullLayout && relayoutChildren && firstLineBox() && !selfNeedsLayout() && !clearLinesForPagination && lineBoxesSurviveLogicalWidthChange())
+        isFullLayout = false;
     LineLayoutState layoutState(isFullLayout, repaintLogicalTop, repaintLogicalBottom, flowThread);
 
     if (isFullLayout)
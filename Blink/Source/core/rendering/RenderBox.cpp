@@ -1661,6 +1661,16 @@ void RenderBox::mapLocalToContainer(const RenderLayerModelObject* repaintContain
         }
     }
 
+    // Mapping every quad of a subtree to the view would otherwise walk all the containers above its layer each time.
+    LayoutSize offsetToView;
+    if (!repaintContainer && (mode & (UseTransforms | IsFixed)) == UseTransforms && hasLayer() && layer()->cachedOffsetToView(offsetToView)) {
+        transformState.move(offsetToView);
+        if (wasFixed)
+            *wasFixed = false;
+        view()->mapLocalToContainer(0, transformState, mode & ~ApplyContainerFlip, wasFixed);
+        return;
+    }
+
     bool containerSkipped;
     RenderObject* o = container(repaintContainer, &containerSkipped);
     if (!o)
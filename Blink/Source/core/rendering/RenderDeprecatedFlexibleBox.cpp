@@ -254,6 +254,8 @@ void RenderDeprecatedFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
 {
     ASSERT(needsLayout());
 
+    invalidateChildHitTestIndex();
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
@@ -323,6 +323,8 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
 {
     ASSERT(needsLayout());
 
+    invalidateChildHitTestIndex();
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
@@ -79,6 +79,14 @@ public:
 
     MapCoordinatesFlags mapCoordinatesFlags() const { return m_mapCoordinatesFlags; }
 
+    // True if everything pushed maps to the RenderView by adding accumulatedOffset(), without transforms
+    // (including the view's own), fixed position or point-dependent steps.
+    bool mapsToViewByAccumulatedOffset() const
+    {
+        return m_mapping.size() && !hasNonUniformStep() && !hasTransformStep() && !hasFixedPositionStep();
+    }
+    const LayoutSize& accumulatedOffset() const { return m_accumulatedOffset; }
+
     FloatPoint absolutePoint(const FloatPoint& p) const
     {
         return mapToContainer(p, 0);
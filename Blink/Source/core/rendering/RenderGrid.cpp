@@ -141,6 +141,8 @@ void RenderGrid::layoutBlock(bool relayoutChildren, LayoutUnit)
 {
     ASSERT(needsLayout());
 
+    invalidateChildHitTestIndex();
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
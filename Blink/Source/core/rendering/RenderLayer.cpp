@@ -46,6 +46,7 @@
 
 #include "CSSPropertyNames.h"
 #include "HTMLNames.h"
+#include "RuntimeEnabledFeatures.h"
 #include "core/css/StylePropertySet.h"
 #include "core/css/StyleResolver.h"
 #include "core/dom/Document.h"
@@ -112,6 +113,7 @@
 #include "core/rendering/RenderTreeAsText.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/svg/RenderSVGResourceClipper.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include <wtf/MemoryInstrumentationVector.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/text/CString.h>
@@ -138,6 +140,34 @@ bool ClipRect::intersects(const HitTestLocation& hitTestLocation) const
     return hitTestLocation.intersects(m_rect);
 }
 
+// Starts at one so that a new layer's generation of zero never matches.
+unsigned RenderLayer::s_geometryGeneration = 1;
+unsigned RenderLayer::s_contentGeneration = 1;
+unsigned RenderLayer::s_recordedLayerCount = 0;
+
+// Very large dirty rects are painted directly instead of being recorded.
+static const int maximumRecordedContentsSize = 4096;
+
+struct RenderLayer::RecordedContents {
+    WTF_MAKE_NONCOPYABLE(RecordedContents); WTF_MAKE_FAST_ALLOCATED;
+public:
+    RecordedContents(const IntRect& inBounds, const IntRect& inLayerBounds, PaintLayerFlags inPaintFlags, const LayoutSize& inSubPixelAccumulation)
+        : bounds(inBounds)
+        , layerBounds(inLayerBounds)
+        , paintFlags(inPaintFlags)
+        , subPixelAccumulation(inSubPixelAccumulation)
+        , contentGeneration(s_contentGeneration)
+    {
+    }
+
+    SkPicture picture;
+    IntRect bounds; // The recorded part of layerBounds, relative to the layer.
+    IntRect layerBounds;
+    PaintLayerFlags paintFlags;
+    LayoutSize subPixelAccumulation;
+    unsigned contentGeneration;
+};
+
 RenderLayer::RenderLayer(RenderLayerModelObject* renderer)
     : m_inResizeMode(false)
     , m_scrollDimensionsDirty(true)
@@ -177,6 +207,9 @@ RenderLayer::RenderLayer(RenderLayerModelObject* renderer)
     , m_next(0)
     , m_first(0)
     , m_last(0)
+    , m_cachedOffsetToViewGeneration(0)
+    , m_hasCachedOffsetToView(false)
+    , m_lastPaintContentGeneration(0)
     , m_staticInlinePosition(0)
     , m_staticBlockPosition(0)
     , m_reflection(0)
@@ -244,6 +277,8 @@ RenderLayer::~RenderLayer()
 
     removeFilterInfoIfNeeded();
 
+    clearRecordedContents();
+
     // Child layers will be deleted by their corresponding render objects, so
     // we don't need to delete them ourselves.
 
@@ -2201,6 +2236,26 @@ void RenderLayer::scrollToOffset(const IntSize& scrollOffset, ScrollOffsetClampi
         scrollToOffsetWithoutAnimation(IntPoint(newScrollOffset));
 }
 
+bool RenderLayer::cachedOffsetToView(LayoutSize& offset)
+{
+    // Renderers move during layout, and may already have been moved or removed if layout is pending.
+    RenderView* view = renderer()->view();
+    FrameView* frameView = view ? view->frameView() : 0;
+    if (!frameView || frameView->isInLayout() || frameView->needsLayout())
+        return false;
+
+    if (m_cachedOffsetToViewGeneration != s_geometryGeneration) {
+        RenderGeometryMap geometryMap(UseTransforms);
+        geometryMap.pushMappingsToAncestor(renderer(), 0);
+        m_hasCachedOffsetToView = geometryMap.mapsToViewByAccumulatedOffset();
+        m_cachedOffsetToView = geometryMap.accumulatedOffset();
+        m_cachedOffsetToViewGeneration = s_geometryGeneration;
+    }
+
+    offset = m_cachedOffsetToView;
+    return m_hasCachedOffsetToView;
+}
+
 void RenderLayer::scrollTo(int x, int y)
 {
     RenderBox* box = renderBox();
@@ -2222,6 +2277,7 @@ void RenderLayer::scrollTo(int x, int y)
     if (m_scrollOffset == newScrollOffset)
         return;
     m_scrollOffset = newScrollOffset;
+    invalidateCachedGeometry();
 
     Frame* frame = renderer()->frame();
     InspectorInstrumentation::willScrollLayer(frame);
@@ -3673,7 +3729,10 @@ void RenderLayer::paintLayer(GraphicsContext* context, const LayerPaintingInfo&
 
         return;
     }
-    
+
+    if (paintRecordedContents(context, paintingInfo, paintFlags))
+        return;
+
     paintLayerContentsAndReflection(context, paintingInfo, paintFlags);
 }
 
@@ -3934,6 +3993,142 @@ void RenderLayer::paintLayerByApplyingTransform(GraphicsContext* context, const
     paintLayerContentsAndReflection(context, transformedPaintingInfo, paintFlags);
 }
 
+// A layer whose contents paint unchanged twice in a row records the dirty part of them into a picture
+// and replays it until one of the renderers it paints is repainted, the content generation changes or
+// a paint needs more than was recorded. Like a transformed layer, the picture is painted with the layer
+// as the root, so it stays valid when the layer moves relative to the view, e.g. when the frame scrolls.
+bool RenderLayer::paintRecordedContents(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
+{
+    if (!canRecordContents(context, paintingInfo, paintFlags))
+        return false;
+
+    // This involves subtracting out the position of the layer in our current coordinate space, but preserving
+    // the accumulated error for sub-pixel layout.
+    LayoutPoint delta;
+    convertToLayerCoords(paintingInfo.rootLayer, delta);
+    IntPoint roundedDelta = roundedIntPoint(delta);
+    LayoutSize adjustedSubPixelAccumulation = paintingInfo.subPixelAccumulation + (delta - roundedDelta);
+
+    if (m_recordedContents && (m_recordedContents->contentGeneration != s_contentGeneration
+        || m_recordedContents->paintFlags != paintFlags || m_recordedContents->subPixelAccumulation != adjustedSubPixelAccumulation))
+        clearRecordedContents();
+
+    IntRect dirtyRect = enclosingIntRect(paintingInfo.paintDirtyRect);
+    dirtyRect.move(-roundedDelta.x(), -roundedDelta.y());
+
+    // Painting outside the recorded part drops the recording. The next paint records the new dirty rect.
+    if (m_recordedContents && !m_recordedContents->bounds.contains(intersection(dirtyRect, m_recordedContents->layerBounds)))
+        clearRecordedContents();
+
+    if (!m_recordedContents) {
+        bool paintedUnchangedContents = m_lastPaintContentGeneration == s_contentGeneration;
+        m_lastPaintContentGeneration = s_contentGeneration;
+        if (!paintedUnchangedContents || !canReplayRecordedContents())
+            return false;
+
+        IntRect layerBounds = calculateLayerBounds(this);
+        IntRect bounds = intersection(layerBounds, dirtyRect);
+        if (bounds.isEmpty() || bounds.width() > maximumRecordedContentsSize || bounds.height() > maximumRecordedContentsSize)
+            return false;
+
+        OwnPtr<RecordedContents> recordedContents = adoptPtr(new RecordedContents(bounds, layerBounds, paintFlags, adjustedSubPixelAccumulation));
+        context->beginRecording(&recordedContents->picture, bounds.size());
+        {
+            GraphicsContextStateSaver stateSaver(*context);
+            context->translate(-bounds.x(), -bounds.y());
+
+            // Clip rects cached for painting are relative to the real root, so don't use them while we are the root.
+            LayerPaintingInfo recordingPaintingInfo(this, bounds, paintingInfo.paintBehavior, adjustedSubPixelAccumulation);
+            paintLayerContentsAndReflection(context, recordingPaintingInfo, paintFlags | PaintLayerTemporaryClipRects);
+        }
+        context->endRecording();
+
+        m_recordedContents = recordedContents.release();
+        ++s_recordedLayerCount;
+    }
+
+    // Make sure the parent's clip rects have been calculated.
+    ClipRect clipRect = paintingInfo.paintDirtyRect;
+    if (parent()) {
+        ClipRectsContext clipRectsContext(paintingInfo.rootLayer, paintingInfo.region, PaintingClipRects);
+        clipRect = backgroundClipRect(clipRectsContext);
+        clipRect.intersect(paintingInfo.paintDirtyRect);
+
+        // Push the parent coordinate space's clip.
+        parent()->clipToRect(paintingInfo.rootLayer, context, paintingInfo.paintDirtyRect, clipRect);
+    }
+
+    context->drawPicture(&m_recordedContents->picture, roundedDelta + toIntSize(m_recordedContents->bounds.location()));
+
+    // Restore the clip.
+    if (parent())
+        parent()->restoreClip(context, paintingInfo.paintDirtyRect, clipRect);
+
+    return true;
+}
+
+bool RenderLayer::canRecordContents(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags) const
+{
+    if (!RuntimeEnabledFeatures::recordedLayerContentsEnabled())
+        return false;
+
+    // Recordings don't nest; an ancestor's recording already includes this layer.
+    if (context->paintingDisabled() || context->updatingControlTints() || context->printing() || context->isRecording() || context->isTrackingOpaqueRegion())
+        return false;
+
+    if ((paintFlags & ~PaintLayerPaintingCompositingAllPhases) || paintingInfo.paintBehavior != PaintBehaviorNormal
+        || paintingInfo.paintingRoot || paintingInfo.region || paintingInfo.overlapTestRequests || !paintingInfo.clipToDirtyRect)
+        return false;
+
+    // The picture is recorded without the context's transform and replayed under it. Images pick their
+    // resampling from the total matrix, so anything but a whole-pixel translation would change how they paint.
+    AffineTransform ctm = context->getCTM();
+    if (!ctm.isIdentityOrTranslation() || ctm.e() != round(ctm.e()) || ctm.f() != round(ctm.f()))
+        return false;
+
+    return isSelfPaintingLayer() && !isRootLayer() && !isComposited() && !paintsWithFilters() && !m_reflection && !enclosingPaginationLayer();
+}
+
+bool RenderLayer::canReplayRecordedContents() const
+{
+    // Replaying skips the side effects of painting, such as positioning widgets and marking overlay
+    // scrollbars dirty, and can't follow anything that moves relative to the layer without repainting it.
+    for (RenderObject* descendant = renderer(); descendant; descendant = descendant->nextInPreOrder(renderer())) {
+        if (descendant->isWidget() || descendant->style()->hasFixedBackgroundImage())
+            return false;
+        if (!descendant->hasLayer())
+            continue;
+
+        RenderLayer* layer = toRenderLayerModelObject(descendant)->layer();
+        if (layer->hasOverlayScrollbars())
+            return false;
+        if (layer != this && (layer->isComposited() || descendant->style()->position() == FixedPosition || descendant->style()->position() == StickyPosition))
+            return false;
+    }
+    return true;
+}
+
+void RenderLayer::clearRecordedContents()
+{
+    if (!m_recordedContents)
+        return;
+
+    m_recordedContents.clear();
+    m_lastPaintContentGeneration = 0;
+    ASSERT(s_recordedLayerCount);
+    --s_recordedLayerCount;
+}
+
+void RenderLayer::invalidateRecordedContents()
+{
+    // Non-composited layers paint into the recorded contents of their ancestors.
+    for (RenderLayer* layer = this; layer; layer = layer->parent()) {
+        layer->clearRecordedContents();
+        if (layer->isComposited())
+            break;
+    }
+}
+
 void RenderLayer::paintList(Vector<RenderLayer*>* list, GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
 {
     if (!list)
@@ -487,6 +487,26 @@ public:
 
     const LayoutSize& paintOffset() const { return m_paintOffset; }
 
+    // The offset from our renderer to the RenderView, if mapping there is a plain translation. It is
+    // computed once and reused until the next layout, scroll or style change anywhere.
+    bool cachedOffsetToView(LayoutSize&);
+
+    // Bumped by any layout, scroll, style or render tree change. Geometry cached against a
+    // generation stays valid for as long as the generation is unchanged.
+    static unsigned geometryGeneration() { return s_geometryGeneration; }
+    static void invalidateCachedGeometry()
+    {
+        ++s_geometryGeneration;
+        ++s_contentGeneration;
+    }
+    // Scrolling the frame moves layers relative to the view, but doesn't change what they paint.
+    static void invalidateCachedGeometryForFrameScroll() { ++s_geometryGeneration; }
+
+    // See paintRecordedContents(). Invalidating drops the recorded contents of this layer and of
+    // the ancestors it paints into.
+    static bool hasRecordedContents() { return s_recordedLayerCount; }
+    void invalidateRecordedContents();
+
     void clearClipRectsIncludingDescendants(ClipRectsType typeToClear = AllClipRectTypes);
     void clearClipRects(ClipRectsType typeToClear = AllClipRectTypes);
 
@@ -936,6 +956,10 @@ private:
     void paintLayer(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerContentsAndReflection(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerByApplyingTransform(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags, const LayoutPoint& translationOffset = LayoutPoint());
+    bool paintRecordedContents(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
+    bool canRecordContents(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags) const;
+    bool canReplayRecordedContents() const;
+    void clearRecordedContents();
     void paintLayerContents(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintList(Vector<RenderLayer*>*, GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintPaginatedChildLayer(RenderLayer* childLayer, GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
@@ -1203,6 +1227,19 @@ protected:
     // Paint time offset only, it is used for properly paint relative / sticky positioned elements and exclusion boxes on floats.
     LayoutSize m_paintOffset;
 
+    // See cachedOffsetToView(). Valid while m_cachedOffsetToViewGeneration matches s_geometryGeneration.
+    LayoutSize m_cachedOffsetToView;
+    unsigned m_cachedOffsetToViewGeneration;
+    bool m_hasCachedOffsetToView;
+    static unsigned s_geometryGeneration;
+
+    // See paintRecordedContents(). Recorded contents are valid while their generation matches s_contentGeneration.
+    struct RecordedContents;
+    OwnPtr<RecordedContents> m_recordedContents;
+    unsigned m_lastPaintContentGeneration;
+    static unsigned s_contentGeneration;
+    static unsigned s_recordedLayerCount;
+
     // Our (x,y) coordinates are in our parent layer's coordinate space.
     LayoutPoint m_topLeft;
 
@@ -49,6 +49,7 @@
 #include "core/platform/ScrollbarTheme.h"
 #include "core/platform/chromium/TraceEvent.h"
 #include "core/platform/graphics/GraphicsLayer.h"
+#include "core/platform/graphics/IntPointHash.h"
 #include "core/platform/graphics/transforms/TransformState.h"
 #include "core/rendering/HitTestResult.h"
 #include "core/rendering/RenderApplet.h"
@@ -79,12 +80,25 @@ namespace WebCore {
 
 using namespace HTMLNames;
 
+// Rects are bucketed into a uniform grid once a container holds enough of
+// them for the linear scan to dominate; pages with long lists of positioned
+// items otherwise make overlap testing quadratic in the number of layers.
+static const unsigned overlapMapGridThreshold = 32;
+static const int overlapMapGridCellSizeLog2 = 9;
+// Rects (and queries) covering more cells than this are tested linearly.
+static const int overlapMapMaxCellsPerRect = 64;
+
 class OverlapMapContainer {
 public:
     void add(const IntRect& bounds)
     {
         m_layerRects.append(bounds);
         m_boundingBox.unite(bounds);
+        if (m_layerRects.size() == overlapMapGridThreshold) {
+            for (unsigned i = 0; i < m_layerRects.size(); ++i)
+                addToGrid(i);
+        } else if (m_layerRects.size() > overlapMapGridThreshold)
+            addToGrid(m_layerRects.size() - 1);
     }
 
     bool overlapsLayers(const IntRect& bounds) const
@@ -94,21 +108,81 @@ public:
         // never overlap with each other.
         if (!bounds.intersects(m_boundingBox))
             return false;
-        for (unsigned i = 0; i < m_layerRects.size(); i++) {
-            if (m_layerRects[i].intersects(bounds))
-                return true;
+        IntRect cells = cellsForRect(bounds);
+        if (m_layerRects.size() < overlapMapGridThreshold || coversTooManyCells(cells)) {
+            for (unsigned i = 0; i < m_layerRects.size(); i++) {
+                if (m_layerRects[i].intersects(bounds))
+                    return true;
+            }
+            return false;
+        }
+        if (intersectsAny(m_largeRects, bounds))
+            return true;
+        for (int y = cells.y(); y < cells.maxY(); ++y) {
+            for (int x = cells.x(); x < cells.maxX(); ++x) {
+                GridMap::const_iterator it = m_grid.find(IntPoint(x, y));
+                if (it != m_grid.end() && intersectsAny(it->value, bounds))
+                    return true;
+            }
         }
         return false;
     }
 
     void unite(const OverlapMapContainer& otherContainer)
     {
-        m_layerRects.append(otherContainer.m_layerRects);
-        m_boundingBox.unite(otherContainer.m_boundingBox);
+        for (unsigned i = 0; i < otherContainer.m_layerRects.size(); ++i)
+            add(otherContainer.m_layerRects[i]);
     }
 private:
+    typedef HashMap<IntPoint, Vector<unsigned> > GridMap;
+
+    static IntRect cellsForRect(const IntRect& rect)
+    {
+        int minX = rect.x() >> overlapMapGridCellSizeLog2;
+        int minY = rect.y() >> overlapMapGridCellSizeLog2;
+        int maxX = ((rect.maxX() - 1) >> overlapMapGridCellSizeLog2) + 1;
+        int maxY = ((rect.maxY() - 1) >> overlapMapGridCellSizeLog2) + 1;
+        return IntRect(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    static bool coversTooManyCells(const IntRect& cells)
+    {
+        if (cells.width() > overlapMapMaxCellsPerRect || cells.height() > overlapMapMaxCellsPerRect)
+            return true;
+        return cells.width() * cells.height() > overlapMapMaxCellsPerRect;
+    }
+
+    bool intersectsAny(const Vector<unsigned>& indices, const IntRect& bounds) const
+    {
+        for (unsigned i = 0; i < indices.size(); ++i) {
+            if (m_layerRects[indices[i]].intersects(bounds))
+                return true;
+        }
+        return false;
+    }
+
+    void addToGrid(unsigned index)
+    {
+        const IntRect& rect = m_layerRects[index];
+        // Empty rects never overlap anything.
+        if (rect.isEmpty())
+            return;
+        IntRect cells = cellsForRect(rect);
+        if (coversTooManyCells(cells)) {
+            m_largeRects.append(index);
+            return;
+        }
+        for (int y = cells.y(); y < cells.maxY(); ++y) {
+            for (int x = cells.x(); x < cells.maxX(); ++x)
+                m_grid.add(IntPoint(x, y), Vector<unsigned>()).iterator->value.append(index);
+        }
+    }
+
     Vector<IntRect> m_layerRects;
     IntRect m_boundingBox;
+    // Indices into m_layerRects, only populated past overlapMapGridThreshold.
+    GridMap m_grid;
+    Vector<unsigned> m_largeRects;
 };
 
 class RenderLayerCompositor::OverlapMap {
@@ -392,8 +466,10 @@ void RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
         bool saw3DTransform = false;
         {
             TRACE_EVENT0("blink_rendering", "RenderLayerCompositor::computeCompositingRequirements");
+            InspectorInstrumentation::willComputeCompositingRequirements(m_renderView->frameView()->frame());
             OverlapMap overlapTestRequestMap;
             computeCompositingRequirements(0, updateRoot, &overlapTestRequestMap, compState, layersChanged, saw3DTransform);
+            InspectorInstrumentation::didComputeCompositingRequirements(m_renderView->frameView()->frame());
         }
         needHierarchyUpdate |= layersChanged;
     }
@@ -46,6 +46,7 @@ RenderLazyBlock::RenderLazyBlock(Element* element)
     , m_lastVisibleChildBox(0)
     , m_attached(false)
     , m_isNestedLayout(false)
+    , m_isForcedLayout(false)
 {
     setChildrenInline(false); // All of our children must be block-level.
 }
@@ -67,6 +68,21 @@ void RenderLazyBlock::willBeRemovedFromTree()
     detachLazyBlock();
 }
 
+bool RenderLazyBlock::markSkippedAncestorsForLayout(RenderObject* renderer)
+{
+    bool marked = false;
+    for (RenderObject* child = renderer; child->parent(); child = child->parent()) {
+        if (!child->parent()->isRenderLazyBlock() || !child->isBox() || !child->needsLayout())
+            continue;
+        RenderLazyBlock* block = toRenderLazyBlock(child->parent());
+        block->m_forcedLayoutChildren.add(toRenderBox(child));
+        block->m_isForcedLayout = true;
+        block->setNeedsLayout(true);
+        marked = true;
+    }
+    return marked;
+}
+
 bool RenderLazyBlock::isNested() const
 {
     for (RenderObject* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
@@ -155,6 +171,11 @@ void RenderLazyBlock::layoutChildren(bool relayoutChildren)
     m_firstVisibleChildBox = 0;
     m_lastVisibleChildBox = 0;
 
+    // Children forced by geometry queries stay laid out for real until a
+    // layout that was not requested by such a query.
+    if (!m_isForcedLayout)
+        m_forcedLayoutChildren.clear();
+
     // FIXME: This should approximate the height so we don't actually need to walk
     // every child and can optimistically layout children until we fill the
     // the expandedViewportRect.
@@ -169,7 +190,9 @@ void RenderLazyBlock::layoutChildren(bool relayoutChildren)
         if (relayoutChildren)
             child->setNeedsLayout(true, MarkOnlyThis);
 
-        if (child->style()->logicalHeight().isSpecified()) {
+        // A child that script queried geometry in always gets a real layout,
+        // wherever it is relative to the viewport.
+        if (child->style()->logicalHeight().isSpecified() && !m_forcedLayoutChildren.contains(child)) {
             LogicalExtentComputedValues computedValues;
             child->computeLogicalHeight(-1, height, computedValues);
             child->setLogicalHeight(computedValues.m_extent);
@@ -179,7 +202,7 @@ void RenderLazyBlock::layoutChildren(bool relayoutChildren)
             // on every non fixed height child.
             setLogicalHeight(height);
             setLogicalTopForChild(child, height);
-            if (heightOfChildren && child->needsLayout())
+            if (heightOfChildren && child->needsLayout() && !m_forcedLayoutChildren.contains(child))
                 child->setLogicalHeight(heightOfChildren / childCount);
             else
                 child->layoutIfNeeded();
@@ -203,6 +226,8 @@ void RenderLazyBlock::layoutChildren(bool relayoutChildren)
         height += child->logicalHeight();
     }
 
+    m_isForcedLayout = false;
+
     setLogicalHeight(height + afterEdge);
 
     updateLogicalHeight();
@@ -212,6 +237,8 @@ void RenderLazyBlock::layoutBlock(bool relayoutChildren, LayoutUnit pageLogicalH
 {
     ASSERT(needsLayout());
 
+    invalidateChildHitTestIndex();
+
     if (!m_attached)
         attachLazyBlock();
 
@@ -32,6 +32,7 @@
 #define RenderLazyBlock_h
 
 #include "core/rendering/RenderBlock.h"
+#include "wtf/HashSet.h"
 
 namespace WebCore {
 
@@ -55,6 +56,13 @@ public:
     RenderBox* firstVisibleChildBox() const { return m_firstVisibleChildBox; }
     RenderBox* lastVisibleChildBox() const { return m_lastVisibleChildBox; }
 
+    // Children outside the expanded viewport only get an estimated height and
+    // are left needing layout. Marks every lazy block ancestor of |renderer|
+    // that skipped the child containing it so that layouts lay that child out
+    // for real until the next layout that was not forced this way. Returns
+    // true if any block was marked.
+    static bool markSkippedAncestorsForLayout(RenderObject*);
+
 private:
     virtual void paintChildren(PaintInfo& forSelf, const LayoutPoint&, PaintInfo& forChild, bool usePrintRect) OVERRIDE;
 
@@ -72,8 +80,12 @@ private:
     RenderLazyBlock* m_previous;
     RenderBox* m_firstVisibleChildBox;
     RenderBox* m_lastVisibleChildBox;
+    // Children that geometry queries forced to be laid out. Only compared
+    // against, never dereferenced; cleared by the next normal layout.
+    HashSet<RenderBox*> m_forcedLayoutChildren;
     bool m_attached;
     bool m_isNestedLayout;
+    bool m_isForcedLayout;
     LayoutRect m_intersectRect;
     IntRect m_expandedViewportRect;
 };
@@ -749,10 +749,22 @@ void RenderObject::checkBlockPositionedObjectsNeedLayout()
 }
 #endif
 
+static inline void tableCellPreferredLogicalWidthsChanged(const RenderObject* cell)
+{
+    // The cell's contribution to its table's columns is stale, so the table cannot just fold in appended rows.
+    if (!toRenderTableCell(cell)->hasComputedPreferredLogicalWidths())
+        return;
+    RenderBlock* table = cell->containingBlock();
+    if (table && table->isTable())
+        toRenderTable(table)->setCellPreferredLogicalWidthsChanged();
+}
+
 void RenderObject::setPreferredLogicalWidthsDirty(bool shouldBeDirty, MarkingBehavior markParents)
 {
     bool alreadyDirty = preferredLogicalWidthsDirty();
     m_bitfields.setPreferredLogicalWidthsDirty(shouldBeDirty);
+    if (shouldBeDirty && !alreadyDirty && isTableCell())
+        tableCellPreferredLogicalWidthsChanged(this);
     if (shouldBeDirty && !alreadyDirty && markParents == MarkContainingBlockChain && (isText() || !style()->hasOutOfFlowPosition()))
         invalidateContainerPreferredLogicalWidths();
 }
@@ -770,6 +782,8 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             break;
 
         o->m_bitfields.setPreferredLogicalWidthsDirty(true);
+        if (o->isTableCell())
+            tableCellPreferredLogicalWidthsChanged(o);
         if (o->style()->hasOutOfFlowPosition())
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
@@ -1353,6 +1367,11 @@ RenderLayerModelObject* RenderObject::containerForRepaint() const
 
 void RenderObject::repaintUsingContainer(const RenderLayerModelObject* repaintContainer, const IntRect& r) const
 {
+    if (RenderLayer::hasRecordedContents()) {
+        if (RenderLayer* layer = enclosingLayer())
+            layer->invalidateRecordedContents();
+    }
+
     if (!repaintContainer) {
         view()->repaintViewRectangle(r);
         return;
@@ -1821,6 +1840,7 @@ void RenderObject::setStyle(PassRefPtr<RenderStyle> style)
     
     RefPtr<RenderStyle> oldStyle = m_style.release();
     setStyleInternal(style);
+    RenderLayer::invalidateCachedGeometry();
 
     updateFillImages(oldStyle ? oldStyle->backgroundLayers() : 0, m_style ? m_style->backgroundLayers() : 0);
     updateFillImages(oldStyle ? oldStyle->maskLayers() : 0, m_style ? m_style->maskLayers() : 0);
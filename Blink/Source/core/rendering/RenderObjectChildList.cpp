@@ -28,7 +28,9 @@
 #include "core/rendering/RenderObjectChildList.h"
 
 #include "core/accessibility/AXObjectCache.h"
+#include "core/rendering/RenderBlock.h"
 #include "core/rendering/RenderCounter.h"
+#include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderObject.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/style/RenderStyle.h"
@@ -104,6 +106,11 @@ RenderObject* RenderObjectChildList::removeChildNode(RenderObject* owner, Render
     oldChild->setNextSibling(0);
     oldChild->setParent(0);
 
+    // Cached layer geometry and the hit test index of the block may point at the removed child.
+    RenderLayer::invalidateCachedGeometry();
+    if (owner->isRenderBlock())
+        toRenderBlock(owner)->invalidateChildHitTestIndex();
+
     // rendererRemovedFromTree walks the whole subtree. We can improve performance
     // by skipping this step when destroying the entire tree.
     if (!owner->documentBeingDestroyed())
@@ -150,6 +157,10 @@ void RenderObjectChildList::insertChildNode(RenderObject* owner, RenderObject* n
         setLastChild(newChild);
     }
 
+    RenderLayer::invalidateCachedGeometry();
+    if (owner->isRenderBlock())
+        toRenderBlock(owner)->invalidateChildHitTestIndex();
+
     if (!owner->documentBeingDestroyed() && notifyRenderer)
         newChild->insertedIntoTree();
 
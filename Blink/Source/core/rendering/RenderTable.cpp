@@ -57,6 +57,7 @@ RenderTable::RenderTable(Element* element)
     , m_collapsedBordersValid(false)
     , m_hasColElements(false)
     , m_needsSectionRecalc(false)
+    , m_cellPreferredLogicalWidthsChanged(true)
     , m_columnLogicalWidthChanged(false)
     , m_columnRenderersValid(false)
     , m_hSpacing(0)
@@ -221,9 +221,16 @@ public:
         if (documentBeingDestroyed())
             return;
         m_needsSectionRecalc = true;
+        m_cellPreferredLogicalWidthsChanged = true;
         setNeedsLayout(true);
     }
 
+    // Cleared by AutoTableLayout once it has measured every cell. Until a cell that was measured changes
+    // or the grid is rebuilt, it only needs to measure the rows appended to the last section.
+    bool cellPreferredLogicalWidthsChanged() const { return m_cellPreferredLogicalWidthsChanged; }
+    void setCellPreferredLogicalWidthsChanged() { m_cellPreferredLogicalWidthsChanged = true; }
+    void clearCellPreferredLogicalWidthsChanged() { m_cellPreferredLogicalWidthsChanged = false; }
+
     RenderTableSection* sectionAbove(const RenderTableSection*, SkipEmptySectionsValue = DoNotSkipEmptySections) const;
     RenderTableSection* sectionBelow(const RenderTableSection*, SkipEmptySectionsValue = DoNotSkipEmptySections) const;
 
@@ -328,6 +335,7 @@ private:
 
     mutable bool m_hasColElements : 1;
     mutable bool m_needsSectionRecalc : 1;
+    bool m_cellPreferredLogicalWidthsChanged : 1;
 
     bool m_columnLogicalWidthChanged : 1;
     mutable bool m_columnRenderersValid: 1;
@@ -55,6 +55,9 @@ public:
     // Called from HTMLTableCellElement.
     void colSpanOrRowSpanChanged();
 
+    // A cell that was never measured cannot contribute to its table's column widths yet.
+    bool hasComputedPreferredLogicalWidths() const { return m_minPreferredLogicalWidth != -1; }
+
     void setCol(unsigned column)
     {
         if (UNLIKELY(column > maxColumnIndex))
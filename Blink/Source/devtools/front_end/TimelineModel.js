@@ -61,6 +61,7 @@ WebInspector.TimelineModel.RecordType = {
     DecodeImage: "DecodeImage",
     ResizeImage: "ResizeImage",
     CompositeLayers: "CompositeLayers",
+    ComputeCompositingRequirements: "ComputeCompositingRequirements",
 
     ParseHTML: "ParseHTML",
 
@@ -235,6 +235,31 @@ class V8EXPORT CpuProfiler {
    */
   void DeleteAllCpuProfiles();
 
+  /**
+   * Starts always-on sampling that, instead of building a profile tree,
+   * counts samples per unique call stack. |samples_per_second| is
+   * rounded to a whole fraction of the profiler's base sampling rate;
+   * while a CPU profile is being collected sampling runs at the full
+   * rate. At most |max_unique_stacks| distinct stacks are kept between
+   * snapshots, samples of further stacks are dropped. Does nothing if
+   * continuous sampling is already running.
+   */
+  void StartContinuousSampling(int samples_per_second = 100,
+                               int max_unique_stacks = 4096);
+
+  /** Stops continuous sampling and discards stacks not yet snapshotted. */
+  void StopContinuousSampling();
+
+  /**
+   * Writes the stacks sampled since the previous call in the folded
+   * format understood by flame graph tools, one
+   * "outermost;...;innermost count" line per unique stack, and resets
+   * the counts. Frames are written as "name resource:line". Returns the
+   * number of samples dropped since the previous snapshot because
+   * |max_unique_stacks| distinct stacks had already been sampled.
+   */
+  unsigned TakeFoldedStacksSnapshot(OutputStream* stream);
+
  private:
   CpuProfiler();
   ~CpuProfiler();
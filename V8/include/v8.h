@@ -2302,6 +2302,41 @@ class V8EXPORT Function : public Object {
  */
 class V8EXPORT ArrayBuffer : public Object {
  public:
+  /**
+   * Called to release a backing store that was handed to V8 together with
+   * this callback, once V8 no longer references it.
+   */
+  typedef void (*ReleaseCallback)(void* data,
+                                  size_t byte_length,
+                                  void* parameter);
+
+  /**
+   * The backing store of an ArrayBuffer that has been transferred out of it,
+   * see ArrayBuffer::Transfer. The owner of the contents must either call
+   * Release or pass them to ArrayBuffer::New, possibly in another isolate.
+   */
+  class V8EXPORT Contents {
+   public:
+    Contents()
+        : data_(NULL), byte_length_(0), callback_(NULL), parameter_(NULL) {}
+
+    void* Data() const { return data_; }
+    size_t ByteLength() const { return byte_length_; }
+
+    /**
+     * Frees the memory. Does nothing for memory that was external to V8.
+     */
+    void Release();
+
+   private:
+    void* data_;
+    size_t byte_length_;
+    ReleaseCallback callback_;
+    void* parameter_;
+
+    friend class ArrayBuffer;
+  };
+
   /**
    * Data length in bytes.
    */
@@ -2311,6 +2346,18 @@ class V8EXPORT ArrayBuffer : public Object {
    */
   void* Data() const;
 
+  /**
+   * Returns true if the memory of this ArrayBuffer is not owned by V8.
+   */
+  bool IsExternal() const;
+
+  /**
+   * Detaches the backing store from this ArrayBuffer without copying it and
+   * returns it. This ArrayBuffer and all its views are neutered: they keep
+   * working but have zero length from now on.
+   */
+  Contents Transfer();
+
   /**
    * Create a new ArrayBuffer. Allocate |byte_length| bytes.
    * Allocated memory will be owned by a created ArrayBuffer and
@@ -2325,6 +2372,21 @@ class V8EXPORT ArrayBuffer : public Object {
    */
   static Local<ArrayBuffer> New(void* data, size_t byte_length);
 
+  /**
+   * Create a new ArrayBuffer that takes ownership of an existing memory
+   * block. |callback| is called with |parameter| to release the memory once
+   * the ArrayBuffer is garbage-collected, unless the memory has been
+   * transferred out of it before.
+   */
+  static Local<ArrayBuffer> New(void* data, size_t byte_length,
+                                ReleaseCallback callback, void* parameter);
+
+  /**
+   * Create a new ArrayBuffer over contents transferred out of another
+   * ArrayBuffer. The new ArrayBuffer takes ownership of the contents.
+   */
+  static Local<ArrayBuffer> New(const Contents& contents);
+
   V8_INLINE(static ArrayBuffer* Cast(Value* obj));
 
  private:
@@ -3562,6 +3624,69 @@ class V8EXPORT HeapStatistics {
 };
 
 
+/**
+ * Memory usage of a single heap space.
+ *
+ * The page occupancy histogram is recorded from the live byte counts
+ * found by the last full garbage collection, so watching it over time
+ * shows fragmentation trends without having to walk the heap.
+ */
+class V8EXPORT HeapSpaceStatistics {
+ public:
+  static const int kOccupancyBuckets = 4;
+
+  HeapSpaceStatistics();
+  const char* space_name() { return space_name_; }
+  size_t space_size() { return space_size_; }
+  size_t space_used_size() { return space_used_size_; }
+  size_t space_available_size() { return space_available_size_; }
+  size_t physical_space_size() { return physical_space_size_; }
+  size_t number_of_pages() { return number_of_pages_; }
+
+  /**
+   * Number of pages whose live objects filled between
+   * bucket / kOccupancyBuckets and (bucket + 1) / kOccupancyBuckets of
+   * the page at the last full garbage collection.
+   */
+  size_t pages_with_occupancy(int bucket) {
+    return pages_with_occupancy_[bucket];
+  }
+
+ private:
+  const char* space_name_;
+  size_t space_size_;
+  size_t space_used_size_;
+  size_t space_available_size_;
+  size_t physical_space_size_;
+  size_t number_of_pages_;
+  size_t pages_with_occupancy_[kOccupancyBuckets];
+
+  friend class Isolate;
+};
+
+
+/**
+ * Number and total size of the live objects of one type, as found by
+ * the last full garbage collection.
+ */
+class V8EXPORT HeapObjectStatistics {
+ public:
+  HeapObjectStatistics();
+  const char* object_type() { return object_type_; }
+  const char* object_sub_type() { return object_sub_type_; }
+  size_t object_count() { return object_count_; }
+  size_t object_size() { return object_size_; }
+
+ private:
+  const char* object_type_;
+  const char* object_sub_type_;
+  size_t object_count_;
+  size_t object_size_;
+
+  friend class Isolate;
+};
+
+
 class RetainedObjectInfo;
 
 /**
@@ -3653,6 +3778,33 @@ class V8EXPORT Isolate {
    */
   void GetHeapStatistics(HeapStatistics* heap_statistics);
 
+  /**
+   * Returns the number of spaces in the heap.
+   */
+  size_t NumberOfHeapSpaces();
+
+  /**
+   * Get the memory usage of a space in the heap.  Returns false if no
+   * space exists at the given index.
+   */
+  bool GetHeapSpaceStatistics(HeapSpaceStatistics* space_statistics,
+                              size_t index);
+
+  /**
+   * Returns the number of object types for which statistics are gathered
+   * during garbage collection.
+   */
+  size_t NumberOfTrackedHeapObjectTypes();
+
+  /**
+   * Get statistics about the live objects of a type as found by the last
+   * full garbage collection.  The statistics are only gathered when V8
+   * runs with --track-gc-object-stats; returns false otherwise or if no
+   * object type is tracked at the given index.
+   */
+  bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
+                                       size_t type_index);
+
   /**
    * Adjusts the amount of registered external memory. Used to give V8 an
    * indication of the amount of externally allocated memory that is kept alive
@@ -4376,6 +4528,18 @@ class V8EXPORT V8 {
    */
   static bool IdleNotification(int hint = 1000);
 
+  /**
+   * Optional notification that the embedder is idle for the next
+   * |idle_time_in_ms| milliseconds, e.g. the rest of the current frame.
+   * Unlike IdleNotification, V8 sizes the incremental marking and
+   * sweeping steps it performs from their measured speeds so that the
+   * work ends before this deadline, and only does a full, compacting
+   * collection if it is expected to fit. Returns true if the embedder
+   * should stop calling IdleNotificationInMs until real work has been
+   * done.
+   */
+  static bool IdleNotificationInMs(int idle_time_in_ms);
+
   /**
    * Optional notification that the system is running low on memory.
    * V8 uses these notifications to attempt to free memory.
@@ -5053,7 +5217,7 @@ class Internals {
   static const int kNullValueRootIndex = 7;
   static const int kTrueValueRootIndex = 8;
   static const int kFalseValueRootIndex = 9;
-  static const int kEmptyStringRootIndex = 127;
+  static const int kEmptyStringRootIndex = 128;
 
   static const int kNodeClassIdOffset = 1 * kApiPointerSize;
   static const int kNodeFlagsOffset = 1 * kApiPointerSize + 3;
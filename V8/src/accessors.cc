@@ -601,7 +601,7 @@ static MaybeObject* ConstructArgumentsObjectForInlinedFunction(
     array->set(i, *value);
   }
   arguments->set_elements(*array);
-  args_slots.Dispose();
+  SlotRef::DisposeSlotMapping(args_slots);
 
   // Return the freshly allocated arguments object.
   return *arguments;
@@ -4892,6 +4892,22 @@ HeapStatistics::HeapStatistics(): total_heap_size_(0),
                                   heap_size_limit_(0) { }
 
 
+HeapSpaceStatistics::HeapSpaceStatistics(): space_name_(0),
+                                            space_size_(0),
+                                            space_used_size_(0),
+                                            space_available_size_(0),
+                                            physical_space_size_(0),
+                                            number_of_pages_(0) {
+  for (int i = 0; i < kOccupancyBuckets; i++) pages_with_occupancy_[i] = 0;
+}
+
+
+HeapObjectStatistics::HeapObjectStatistics(): object_type_(0),
+                                              object_sub_type_(0),
+                                              object_count_(0),
+                                              object_size_(0) { }
+
+
 void v8::V8::GetHeapStatistics(HeapStatistics* heap_statistics) {
   i::Isolate* isolate = i::Isolate::UncheckedCurrent();
   if (isolate == NULL || !isolate->IsInitialized()) {
@@ -4965,6 +4981,15 @@ bool v8::V8::IdleNotification(int hint) {
 }
 
 
+bool v8::V8::IdleNotificationInMs(int idle_time_in_ms) {
+  // Returning true tells the caller that it need not
+  // continue to call IdleNotificationInMs.
+  i::Isolate* isolate = i::Isolate::Current();
+  if (isolate == NULL || !isolate->IsInitialized()) return true;
+  return i::V8::IdleNotificationInMs(idle_time_in_ms);
+}
+
+
 void v8::V8::LowMemoryNotification() {
   i::Isolate* isolate = i::Isolate::Current();
   if (isolate == NULL || !isolate->IsInitialized()) return;
@@ -5851,6 +5876,39 @@ void* v8::ArrayBuffer::Data() const {
 }
 
 
+bool v8::ArrayBuffer::IsExternal() const {
+  i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
+  if (IsDeadCheck(isolate, "v8::ArrayBuffer::IsExternal()")) return false;
+  i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
+  return obj->is_external();
+}
+
+
+v8::ArrayBuffer::Contents v8::ArrayBuffer::Transfer() {
+  i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
+  Contents contents;
+  if (IsDeadCheck(isolate, "v8::ArrayBuffer::Transfer()")) return contents;
+  ENTER_V8(isolate);
+  i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
+  contents.data_ = obj->backing_store();
+  contents.byte_length_ = static_cast<size_t>(obj->byte_length()->Number());
+  i::Runtime::ArrayBufferReleaseInfo release_info;
+  i::Runtime::TransferArrayBuffer(isolate, obj, &release_info);
+  contents.callback_ = release_info.callback;
+  contents.parameter_ = release_info.parameter;
+  return contents;
+}
+
+
+void v8::ArrayBuffer::Contents::Release() {
+  if (callback_ != NULL) callback_(data_, byte_length_, parameter_);
+  data_ = NULL;
+  byte_length_ = 0;
+  callback_ = NULL;
+  parameter_ = NULL;
+}
+
+
 Local<ArrayBuffer> v8::ArrayBuffer::New(size_t byte_length) {
   i::Isolate* isolate = i::Isolate::Current();
   EnsureInitializedForIsolate(isolate, "v8::ArrayBuffer::New(size_t)");
@@ -5875,6 +5933,32 @@ Local<ArrayBuffer> v8::ArrayBuffer::New(void* data, size_t byte_length) {
 }
 
 
+Local<ArrayBuffer> v8::ArrayBuffer::New(void* data, size_t byte_length,
+                                        ReleaseCallback callback,
+                                        void* parameter) {
+  i::Isolate* isolate = i::Isolate::Current();
+  EnsureInitializedForIsolate(isolate,
+      "v8::ArrayBuffer::New(void*, size_t, ReleaseCallback, void*)");
+  LOG_API(isolate,
+      "v8::ArrayBuffer::New(void*, size_t, ReleaseCallback, void*)");
+  ENTER_V8(isolate);
+  i::Handle<i::JSArrayBuffer> obj =
+      isolate->factory()->NewJSArrayBuffer();
+  i::Runtime::SetupArrayBufferWithReleaseCallback(
+      isolate, obj, data, byte_length, callback, parameter);
+  return Utils::ToLocal(obj);
+}
+
+
+Local<ArrayBuffer> v8::ArrayBuffer::New(const Contents& contents) {
+  if (contents.callback_ == NULL) {
+    return New(contents.data_, contents.byte_length_);
+  }
+  return New(contents.data_, contents.byte_length_,
+             contents.callback_, contents.parameter_);
+}
+
+
 Local<ArrayBuffer> v8::TypedArray::Buffer() {
   i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
   if (IsDeadCheck(isolate, "v8::TypedArray::Buffer()"))
@@ -5936,6 +6020,8 @@ i::Handle<i::JSTypedArray> NewTypedArray(
       static_cast<size_t>(buffer->byte_length()->Number()));
 
   obj->set_buffer(*buffer);
+  obj->set_weak_next(buffer->weak_first_view());
+  buffer->set_weak_first_view(*obj);
 
   i::Handle<i::Object> byte_offset_object = isolate->factory()->NewNumber(
         static_cast<double>(byte_offset));
@@ -6466,6 +6552,93 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
 }
 
 
+size_t Isolate::NumberOfHeapSpaces() {
+  return i::LAST_SPACE - i::FIRST_SPACE + 1;
+}
+
+
+bool Isolate::GetHeapSpaceStatistics(HeapSpaceStatistics* space_statistics,
+                                     size_t index) {
+  STATIC_ASSERT(static_cast<int>(HeapSpaceStatistics::kOccupancyBuckets) ==
+                static_cast<int>(i::PagedSpace::kOccupancyBuckets));
+  if (index >= NumberOfHeapSpaces()) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::AllocationSpace id = static_cast<i::AllocationSpace>(index);
+  space_statistics->space_name_ = i::AllocationSpaceName(id);
+  space_statistics->space_size_ = 0;
+  space_statistics->space_used_size_ = 0;
+  space_statistics->space_available_size_ = 0;
+  space_statistics->physical_space_size_ = 0;
+  space_statistics->number_of_pages_ = 0;
+  for (int i = 0; i < HeapSpaceStatistics::kOccupancyBuckets; i++) {
+    space_statistics->pages_with_occupancy_[i] = 0;
+  }
+  if (!isolate->IsInitialized()) return true;
+
+  i::Heap* heap = isolate->heap();
+  if (id == i::NEW_SPACE) {
+    i::NewSpace* space = heap->new_space();
+    space_statistics->space_size_ = space->CommittedMemory();
+    space_statistics->space_used_size_ = space->SizeOfObjects();
+    space_statistics->space_available_size_ = space->Available();
+    space_statistics->physical_space_size_ = space->CommittedPhysicalMemory();
+    space_statistics->number_of_pages_ =
+        space->CommittedMemory() / i::Page::kPageSize;
+  } else if (id == i::LO_SPACE) {
+    // Every large object page holds exactly one object, and dead ones are
+    // released by the collector, so all pages count as full.
+    i::LargeObjectSpace* space = heap->lo_space();
+    space_statistics->space_size_ = space->CommittedMemory();
+    space_statistics->space_used_size_ = space->SizeOfObjects();
+    space_statistics->space_available_size_ = space->Available();
+    space_statistics->physical_space_size_ = space->CommittedPhysicalMemory();
+    space_statistics->number_of_pages_ = space->PageCount();
+    space_statistics->pages_with_occupancy_[
+        HeapSpaceStatistics::kOccupancyBuckets - 1] = space->PageCount();
+  } else {
+    i::PagedSpace* space = heap->paged_space(id);
+    space_statistics->space_size_ = space->CommittedMemory();
+    space_statistics->space_used_size_ = space->SizeOfObjects();
+    space_statistics->space_available_size_ = space->Available();
+    space_statistics->physical_space_size_ = space->CommittedPhysicalMemory();
+    space_statistics->number_of_pages_ = space->CountTotalPages();
+    for (int i = 0; i < HeapSpaceStatistics::kOccupancyBuckets; i++) {
+      space_statistics->pages_with_occupancy_[i] =
+          space->PagesWithOccupancy(i);
+    }
+  }
+  return true;
+}
+
+
+size_t Isolate::NumberOfTrackedHeapObjectTypes() {
+  return i::Heap::OBJECT_STATS_COUNT;
+}
+
+
+bool Isolate::GetHeapObjectStatisticsAtLastGC(
+    HeapObjectStatistics* object_statistics,
+    size_t type_index) {
+  if (!i::FLAG_track_gc_object_stats) return false;
+  const char* object_type;
+  const char* object_sub_type;
+  if (!i::Heap::GetObjectTypeName(type_index, &object_type, &object_sub_type)) {
+    return false;
+  }
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  object_statistics->object_type_ = object_type;
+  object_statistics->object_sub_type_ = object_sub_type;
+  object_statistics->object_count_ = 0;
+  object_statistics->object_size_ = 0;
+  if (isolate->IsInitialized()) {
+    i::Heap* heap = isolate->heap();
+    object_statistics->object_count_ = heap->ObjectCountAtLastGC(type_index);
+    object_statistics->object_size_ = heap->ObjectSizeAtLastGC(type_index);
+  }
+  return true;
+}
+
+
 String::Utf8Value::Utf8Value(v8::Handle<v8::Value> obj)
     : str_(NULL), length_(0) {
   i::Isolate* isolate = i::Isolate::Current();
@@ -7110,6 +7283,44 @@ void CpuProfiler::DeleteAllCpuProfiles() {
 }
 
 
+void CpuProfiler::StartContinuousSampling(int samples_per_second,
+                                          int max_unique_stacks) {
+  ApiCheck(samples_per_second > 0 && max_unique_stacks > 0,
+           "v8::CpuProfiler::StartContinuousSampling",
+           "Invalid sampling parameters");
+  reinterpret_cast<i::CpuProfiler*>(this)->StartContinuousSampling(
+      samples_per_second, max_unique_stacks);
+}
+
+
+void CpuProfiler::StopContinuousSampling() {
+  reinterpret_cast<i::CpuProfiler*>(this)->StopContinuousSampling();
+}
+
+
+unsigned CpuProfiler::TakeFoldedStacksSnapshot(OutputStream* stream) {
+  ApiCheck(stream->GetOutputEncoding() == OutputStream::kAscii,
+           "v8::CpuProfiler::TakeFoldedStacksSnapshot",
+           "Unsupported output encoding");
+  int chunk_size = stream->GetChunkSize();
+  ApiCheck(chunk_size > 0,
+           "v8::CpuProfiler::TakeFoldedStacksSnapshot",
+           "Invalid stream chunk size");
+  i::List<char> folded;
+  unsigned dropped_samples =
+      reinterpret_cast<i::CpuProfiler*>(this)->SnapshotFoldedStacks(&folded);
+  for (int pos = 0; pos < folded.length(); pos += chunk_size) {
+    int size = i::Min(chunk_size, folded.length() - pos);
+    if (stream->WriteAsciiChunk(&folded[pos], size) ==
+        OutputStream::kAbort) {
+      return dropped_samples;
+    }
+  }
+  stream->EndOfStream();
+  return dropped_samples;
+}
+
+
 static i::HeapGraphEdge* ToInternal(const HeapGraphEdge* edge) {
   return const_cast<i::HeapGraphEdge*>(
       reinterpret_cast<const i::HeapGraphEdge*>(edge));
@@ -290,6 +290,13 @@ TickSample* CpuProfiler::TickSampleEvent() {
 
 
 void CpuProfiler::DeleteAllProfiles() {
+  if (profiles_->is_collecting_folded_stacks()) {
+    // Continuous sampling goes on with the code entries collected so far,
+    // only the titled profiles, including those in progress, are deleted.
+    profiles_->DeleteAllProfiles();
+    UpdateSamplingStride();
+    return;
+  }
   if (is_profiling_) StopProcessor();
   ResetProfiles();
 }
@@ -420,6 +427,7 @@ CpuProfiler::CpuProfiler(Isolate* isolate)
       token_enumerator_(new TokenEnumerator()),
       generator_(NULL),
       processor_(NULL),
+      continuous_sampling_stride_(1),
       need_to_stop_sampler_(false),
       is_profiling_(false) {
 }
@@ -439,6 +447,7 @@ void CpuProfiler::ResetProfiles() {
 void CpuProfiler::StartProfiling(const char* title, bool record_samples) {
   if (profiles_->StartProfiling(title, next_profile_uid_++, record_samples)) {
     StartProcessorIfNotStarted();
+    UpdateSamplingStride();
   }
   processor_->AddCurrentStack();
 }
@@ -506,7 +515,44 @@ CpuProfile* CpuProfiler::StopProfiling(Object* security_token, String* title) {
 
 
 void CpuProfiler::StopProcessorIfLastProfile(const char* title) {
-  if (profiles_->IsLastProfile(title)) StopProcessor();
+  if (!profiles_->IsLastProfile(title)) return;
+  if (profiles_->is_collecting_folded_stacks()) {
+    // Keep sampling, but drop back to the continuous sampling rate.
+    isolate_->logger()->sampler()->SetSamplingStride(
+        continuous_sampling_stride_);
+  } else {
+    StopProcessor();
+  }
+}
+
+
+void CpuProfiler::StartContinuousSampling(int samples_per_second,
+                                          int max_unique_stacks) {
+  ASSERT(samples_per_second > 0);
+  if (!profiles_->StartFoldedStacks(max_unique_stacks)) return;
+  continuous_sampling_stride_ = Max(
+      1, 1000 / (samples_per_second * Logger::kSamplingIntervalMs));
+  StartProcessorIfNotStarted();
+  UpdateSamplingStride();
+}
+
+
+void CpuProfiler::StopContinuousSampling() {
+  if (!profiles_->is_collecting_folded_stacks()) return;
+  profiles_->StopFoldedStacks();
+  if (!profiles_->HasCurrentProfiles()) StopProcessor();
+}
+
+
+unsigned CpuProfiler::SnapshotFoldedStacks(List<char>* output) {
+  return profiles_->SnapshotFoldedStacks(output);
+}
+
+
+void CpuProfiler::UpdateSamplingStride() {
+  // Titled profiles always get every tick.
+  isolate_->logger()->sampler()->SetSamplingStride(
+      profiles_->HasCurrentProfiles() ? 1 : continuous_sampling_stride_);
 }
 
 
@@ -514,6 +560,7 @@ void CpuProfiler::StopProcessor() {
   Logger* logger = isolate_->logger();
   Sampler* sampler = reinterpret_cast<Sampler*>(logger->ticker_);
   sampler->DecreaseProfilingDepth();
+  sampler->SetSamplingStride(1);
   if (need_to_stop_sampler_) {
     sampler->Stop();
     need_to_stop_sampler_ = false;
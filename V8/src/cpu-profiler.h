@@ -217,6 +217,15 @@ class CpuProfiler {
   void DeleteProfile(CpuProfile* profile);
   bool HasDetachedProfiles();
 
+  // Continuous sampling aggregates samples by unique stack instead of
+  // building titled profiles, and may run at a lower rate than they do.
+  void StartContinuousSampling(int samples_per_second, int max_unique_stacks);
+  void StopContinuousSampling();
+  // Appends the stacks sampled since the previous snapshot in folded
+  // format and starts over. Returns the number of samples dropped in
+  // that time because the table was full.
+  unsigned SnapshotFoldedStacks(List<char>* output);
+
   // Invoked from stack sampler (thread or signal handler.)
   TickSample* TickSampleEvent();
 
@@ -254,6 +263,7 @@ class CpuProfiler {
   void StopProcessorIfLastProfile(const char* title);
   void StopProcessor();
   void ResetProfiles();
+  void UpdateSamplingStride();
 
   Isolate* isolate_;
   CpuProfilesCollection* profiles_;
@@ -262,6 +272,8 @@ class CpuProfiler {
   ProfileGenerator* generator_;
   ProfilerEventsProcessor* processor_;
   int saved_logging_nesting_;
+  // Sampler ticks per sample while only continuous sampling is active.
+  int continuous_sampling_stride_;
   bool need_to_stop_sampler_;
   bool is_profiling_;
 
@@ -254,8 +254,8 @@ DeoptimizedFrameInfo* Deoptimizer::DebuggerInspectableFrame(
   // Done with the GC-unsafe frame descriptions. This re-enables allocation.
   deoptimizer->DeleteFrameDescriptions();
 
-  // Allocate a heap number for the doubles belonging to this frame.
-  deoptimizer->MaterializeHeapNumbersForDebuggerInspectableFrame(
+  // Allocate the heap numbers and captured objects belonging to this frame.
+  deoptimizer->MaterializeHeapObjectsForDebuggerInspectableFrame(
       parameters_top, parameters_size, expressions_top, expressions_size, info);
 
   // Finished using the deoptimizer instance.
@@ -537,6 +537,9 @@ Deoptimizer::Deoptimizer(Isolate* isolate,
       deferred_arguments_objects_values_(0),
       deferred_arguments_objects_(0),
       deferred_heap_numbers_(0),
+      deferred_objects_(0),
+      deferred_objects_tagged_values_(0),
+      deferred_objects_double_values_(0),
       trace_(false) {
   // For COMPILED_STUBs called from builtins, the function pointer is a SMI
   // indicating an internal frame.
@@ -778,6 +781,8 @@ void Deoptimizer::DoComputeOutputFrames() {
       case Translation::DOUBLE_STACK_SLOT:
       case Translation::LITERAL:
       case Translation::ARGUMENTS_OBJECT:
+      case Translation::CAPTURED_OBJECT:
+      case Translation::DUPLICATED_OBJECT:
       case Translation::DUPLICATE:
       default:
         UNREACHABLE();
@@ -1214,6 +1219,12 @@ void Deoptimizer::DoComputeConstructStubFrame(TranslationIterator* iterator,
   output_offset -= kPointerSize;
   value = output_frame->GetFrameSlot(output_frame_size - kPointerSize);
   output_frame->SetFrameSlot(output_offset, value);
+  // A receiver replaced by escape analysis is materialized into both slots.
+  int object_index =
+      FindCapturedObjectForSlot(top_address + output_frame_size - kPointerSize);
+  if (object_index >= 0) {
+    AddObjectDuplication(top_address + output_offset, object_index);
+  }
   if (trace_) {
     PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- 0x%08"
            V8PRIxPTR " ; allocated receiver\n",
@@ -1328,7 +1339,18 @@ void Deoptimizer::DoComputeAccessorStubFrame(TranslationIterator* iterator,
   // Skip receiver.
   Translation::Opcode opcode =
       static_cast<Translation::Opcode>(iterator->Next());
-  iterator->Skip(Translation::NumberOfOperandsFor(opcode));
+  if (opcode == Translation::CAPTURED_OBJECT) {
+    // The fields of a captured receiver still have to be consumed, and later
+    // duplicates of it need a materialized object to refer to.
+    int length = iterator->Next();
+    AddObjectStart(0, length);
+    int object_index = deferred_objects_.length() - 1;
+    for (int i = 0; i < length; i++) {
+      DoTranslateObject(iterator, object_index, i);
+    }
+  } else {
+    iterator->Skip(Translation::NumberOfOperandsFor(opcode));
+  }
 
   if (is_setter_stub_frame) {
     // The implicit return value was part of the artificial setter stub
@@ -1564,22 +1586,39 @@ void Deoptimizer::MaterializeHeapObjects(JavaScriptFrameIterator* it) {
                               isolate_));
   }
 
+  // Handlify all captured object field values as well.
+  List<Handle<Object> > object_values(
+      deferred_objects_tagged_values_.length());
+  for (int i = 0; i < deferred_objects_tagged_values_.length(); ++i) {
+    object_values.Add(Handle<Object>(deferred_objects_tagged_values_[i],
+                                     isolate_));
+  }
+
   // Play it safe and clear all unhandlified values before we continue.
   deferred_arguments_objects_values_.Clear();
+  deferred_objects_tagged_values_.Clear();
 
   // Materialize all heap numbers before looking at arguments because when the
   // output frames are used to materialize arguments objects later on they need
   // to already contain valid heap numbers.
   for (int i = 0; i < deferred_heap_numbers_.length(); i++) {
-    HeapNumberMaterializationDescriptor d = deferred_heap_numbers_[i];
+    HeapNumberMaterializationDescriptor<Address> d = deferred_heap_numbers_[i];
     Handle<Object> num = isolate_->factory()->NewNumber(d.value());
     if (trace_) {
       PrintF("Materializing a new heap number %p [%e] in slot %p\n",
              reinterpret_cast<void*>(*num),
              d.value(),
-             d.slot_address());
+             d.destination());
     }
-    Memory::Object_at(d.slot_address()) = *num;
+    Memory::Object_at(d.destination()) = *num;
+  }
+
+  // Materialize captured objects and store them into their frame slots.
+  List<Handle<JSObject> > objects(deferred_objects_.length());
+  MaterializeCapturedObjects(&object_values, &objects);
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    Address slot = deferred_objects_[i].slot_address();
+    if (slot != NULL) Memory::Object_at(slot) = *objects[i];
   }
 
   // Materialize arguments objects one frame at a time.
@@ -1632,8 +1671,102 @@ void Deoptimizer::MaterializeHeapObjects(JavaScriptFrameIterator* it) {
 }
 
 
+void Deoptimizer::MaterializeCapturedObjects(
+    List<Handle<Object> >* object_values,
+    List<Handle<JSObject> >* objects) {
+  // Materialize all heap numbers required for captured objects.
+  for (int i = 0; i < deferred_objects_double_values_.length(); i++) {
+    HeapNumberMaterializationDescriptor<int> d =
+        deferred_objects_double_values_[i];
+    Handle<Object> num = isolate_->factory()->NewNumber(d.value());
+    if (trace_) {
+      PrintF("Materializing a new heap number %p [%e] for object field %d\n",
+             reinterpret_cast<void*>(*num),
+             d.value(),
+             d.destination());
+    }
+    (*object_values)[d.destination()] = num;
+  }
+
+  // Materialize captured objects in translation order, so that duplicates
+  // always refer to an object that has already been allocated.
+  List<Handle<JSObject> > materialized_objects(deferred_objects_.length());
+  int value_index = 0;
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    ObjectMaterializationDescriptor d = deferred_objects_[i];
+    Handle<JSObject> object;
+    if (d.is_duplicate()) {
+      object = materialized_objects[d.duplicate_object()];
+    } else {
+      int length = d.object_length();
+      Handle<Map> map = Handle<Map>::cast(object_values->at(value_index));
+      ASSERT(map->instance_size() == length * kPointerSize);
+      object = isolate_->factory()->NewJSObjectFromMap(map);
+      object->set_properties(
+          FixedArray::cast(*object_values->at(value_index + 1)));
+      object->set_elements(
+          FixedArrayBase::cast(*object_values->at(value_index + 2)));
+      const int header_length = JSObject::kHeaderSize / kPointerSize;
+      for (int j = header_length; j < length; j++) {
+        int index = map->inobject_properties() - (length - j);
+        ASSERT(index >= 0);
+        object->InObjectPropertyAtPut(index,
+                                      *object_values->at(value_index + j));
+      }
+      value_index += length;
+      materialized_objects.Add(object);
+    }
+    objects->Add(object);
+    if (trace_) {
+      PrintF("Materializing %scaptured object for slot %p: ",
+             d.is_duplicate() ? "duplicated " : "",
+             d.slot_address());
+      object->ShortPrint();
+      PrintF("\n");
+    }
+  }
+  ASSERT(value_index == object_values->length());
+}
+
+
 #ifdef ENABLE_DEBUGGER_SUPPORT
-void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
+bool Deoptimizer::SetDebuggerInspectableFrameSlot(DeoptimizedFrameInfo* info,
+                                                  Address slot,
+                                                  Address parameters_top,
+                                                  Address parameters_bottom,
+                                                  Address expressions_top,
+                                                  Address expressions_bottom,
+                                                  Object* value,
+                                                  bool trace) {
+  if (parameters_top <= slot && slot < parameters_bottom) {
+    int index = (info->parameters_count() - 1) -
+        static_cast<int>(slot - parameters_top) / kPointerSize;
+    if (trace) {
+      PrintF("Materializing %p in slot %p for parameter slot #%d\n",
+             reinterpret_cast<void*>(value),
+             slot,
+             index);
+    }
+    info->SetParameter(index, value);
+    return true;
+  }
+  if (expressions_top <= slot && slot < expressions_bottom) {
+    int index = info->expression_count() - 1 -
+        static_cast<int>(slot - expressions_top) / kPointerSize;
+    if (trace) {
+      PrintF("Materializing %p in slot %p for expression slot #%d\n",
+             reinterpret_cast<void*>(value),
+             slot,
+             index);
+    }
+    info->SetExpression(index, value);
+    return true;
+  }
+  return false;
+}
+
+
+void Deoptimizer::MaterializeHeapObjectsForDebuggerInspectableFrame(
     Address parameters_top,
     uint32_t parameters_size,
     Address expressions_top,
@@ -1642,46 +1775,47 @@ void Deoptimizer::MaterializeHeapNumbersForDebuggerInspectableFrame(
   ASSERT_EQ(DEBUGGER, bailout_type_);
   Address parameters_bottom = parameters_top + parameters_size;
   Address expressions_bottom = expressions_top + expressions_size;
+
+  // Handlify all captured object field values before triggering any
+  // allocation.
+  List<Handle<Object> > object_values(
+      deferred_objects_tagged_values_.length());
+  for (int i = 0; i < deferred_objects_tagged_values_.length(); ++i) {
+    object_values.Add(Handle<Object>(deferred_objects_tagged_values_[i],
+                                     isolate_));
+  }
+  deferred_objects_tagged_values_.Clear();
+
   for (int i = 0; i < deferred_heap_numbers_.length(); i++) {
-    HeapNumberMaterializationDescriptor d = deferred_heap_numbers_[i];
+    HeapNumberMaterializationDescriptor<Address> d = deferred_heap_numbers_[i];
 
     // Check of the heap number to materialize actually belong to the frame
     // being extracted.
-    Address slot = d.slot_address();
-    if (parameters_top <= slot && slot < parameters_bottom) {
-      Handle<Object> num = isolate_->factory()->NewNumber(d.value());
-
-      int index = (info->parameters_count() - 1) -
-          static_cast<int>(slot - parameters_top) / kPointerSize;
-
-      if (trace_) {
-        PrintF("Materializing a new heap number %p [%e] in slot %p"
-               "for parameter slot #%d\n",
-               reinterpret_cast<void*>(*num),
-               d.value(),
-               d.slot_address(),
-               index);
-      }
-
-      info->SetParameter(index, *num);
-    } else if (expressions_top <= slot && slot < expressions_bottom) {
+    Address slot = d.destination();
+    if ((parameters_top <= slot && slot < parameters_bottom) ||
+        (expressions_top <= slot && slot < expressions_bottom)) {
       Handle<Object> num = isolate_->factory()->NewNumber(d.value());
-
-      int index = info->expression_count() - 1 -
-          static_cast<int>(slot - expressions_top) / kPointerSize;
-
-      if (trace_) {
-        PrintF("Materializing a new heap number %p [%e] in slot %p"
-               "for expression slot #%d\n",
-               reinterpret_cast<void*>(*num),
-               d.value(),
-               d.slot_address(),
-               index);
-      }
-
-      info->SetExpression(index, *num);
+      SetDebuggerInspectableFrameSlot(info, slot,
+                                      parameters_top, parameters_bottom,
+                                      expressions_top, expressions_bottom,
+                                      *num, trace_);
     }
   }
+
+  // Captured objects are materialized for the whole translation, since the
+  // ones in this frame can be duplicates of objects captured in outer
+  // frames. The frame descriptions are gone, so the objects are only handed
+  // to the frame info.
+  List<Handle<JSObject> > objects(deferred_objects_.length());
+  MaterializeCapturedObjects(&object_values, &objects);
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    Address slot = deferred_objects_[i].slot_address();
+    if (slot == NULL) continue;
+    SetDebuggerInspectableFrameSlot(info, slot,
+                                    parameters_top, parameters_bottom,
+                                    expressions_top, expressions_bottom,
+                                    *objects[i], trace_);
+  }
 }
 #endif
 
@@ -1973,6 +2107,222 @@ void Deoptimizer::DoTranslateCommand(TranslationIterator* iterator,
       }
       return;
     }
+
+    case Translation::CAPTURED_OBJECT: {
+      int length = iterator->Next();
+      if (trace_) {
+        PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- ",
+               output_[frame_index]->GetTop() + output_offset,
+               output_offset);
+        isolate_->heap()->arguments_marker()->ShortPrint();
+        PrintF(" ; object (length = %d)\n", length);
+      }
+      // Use the arguments marker value as a sentinel and fill in the captured
+      // object after the deoptimized frame is built.
+      intptr_t value = reinterpret_cast<intptr_t>(
+          isolate_->heap()->arguments_marker());
+      AddObjectStart(output_[frame_index]->GetTop() + output_offset, length);
+      output_[frame_index]->SetFrameSlot(output_offset, value);
+      // We save the field values on the side and materialize the actual
+      // object after the deoptimized frame is built.
+      int object_index = deferred_objects_.length() - 1;
+      for (int i = 0; i < length; i++) {
+        DoTranslateObject(iterator, object_index, i);
+      }
+      return;
+    }
+
+    case Translation::DUPLICATED_OBJECT: {
+      int object_index = iterator->Next();
+      if (trace_) {
+        PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- ",
+               output_[frame_index]->GetTop() + output_offset,
+               output_offset);
+        isolate_->heap()->arguments_marker()->ShortPrint();
+        PrintF(" ; duplicate of object #%d\n", object_index);
+      }
+      intptr_t value = reinterpret_cast<intptr_t>(
+          isolate_->heap()->arguments_marker());
+      AddObjectDuplication(output_[frame_index]->GetTop() + output_offset,
+                           object_index);
+      output_[frame_index]->SetFrameSlot(output_offset, value);
+      return;
+    }
+  }
+}
+
+
+void Deoptimizer::DoTranslateObject(TranslationIterator* iterator,
+                                    int object_index,
+                                    int field_index) {
+  disasm::NameConverter converter;
+  Translation::Opcode opcode =
+      static_cast<Translation::Opcode>(iterator->Next());
+
+  switch (opcode) {
+    case Translation::BEGIN:
+    case Translation::JS_FRAME:
+    case Translation::ARGUMENTS_ADAPTOR_FRAME:
+    case Translation::CONSTRUCT_STUB_FRAME:
+    case Translation::GETTER_STUB_FRAME:
+    case Translation::SETTER_STUB_FRAME:
+    case Translation::COMPILED_STUB_FRAME:
+    case Translation::DUPLICATE:
+    case Translation::ARGUMENTS_OBJECT:
+    case Translation::CAPTURED_OBJECT:
+    case Translation::DUPLICATED_OBJECT:
+      // Captured objects are never nested.
+      UNREACHABLE();
+      return;
+
+    case Translation::REGISTER: {
+      int input_reg = iterator->Next();
+      intptr_t input_value = input_->GetRegister(input_reg);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- 0x%08" V8PRIxPTR " ; %s ",
+               object_index, field_index, input_value,
+               converter.NameOfCPURegister(input_reg));
+        reinterpret_cast<Object*>(input_value)->ShortPrint();
+        PrintF("\n");
+      }
+      AddObjectTaggedValue(input_value);
+      return;
+    }
+
+    case Translation::INT32_REGISTER: {
+      int input_reg = iterator->Next();
+      intptr_t value = input_->GetRegister(input_reg);
+      bool is_smi = Smi::IsValid(value);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %" V8PRIdPTR " ; %s (%s)\n",
+               object_index, field_index, value,
+               converter.NameOfCPURegister(input_reg),
+               TraceValueType(is_smi, false));
+      }
+      if (is_smi) {
+        intptr_t tagged_value =
+            reinterpret_cast<intptr_t>(Smi::FromInt(static_cast<int>(value)));
+        AddObjectTaggedValue(tagged_value);
+      } else {
+        AddObjectDoubleValue(static_cast<double>(static_cast<int32_t>(value)));
+      }
+      return;
+    }
+
+    case Translation::UINT32_REGISTER: {
+      int input_reg = iterator->Next();
+      uintptr_t value = static_cast<uintptr_t>(input_->GetRegister(input_reg));
+      bool is_smi = (value <= static_cast<uintptr_t>(Smi::kMaxValue));
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %" V8PRIuPTR
+               " ; uint %s (%s)\n",
+               object_index, field_index, value,
+               converter.NameOfCPURegister(input_reg),
+               TraceValueType(is_smi, false));
+      }
+      if (is_smi) {
+        intptr_t tagged_value =
+            reinterpret_cast<intptr_t>(Smi::FromInt(static_cast<int>(value)));
+        AddObjectTaggedValue(tagged_value);
+      } else {
+        AddObjectDoubleValue(static_cast<double>(static_cast<uint32_t>(value)));
+      }
+      return;
+    }
+
+    case Translation::DOUBLE_REGISTER: {
+      int input_reg = iterator->Next();
+      double value = input_->GetDoubleRegister(input_reg);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %e ; %s\n",
+               object_index, field_index, value,
+               DoubleRegister::AllocationIndexToString(input_reg));
+      }
+      AddObjectDoubleValue(value);
+      return;
+    }
+
+    case Translation::STACK_SLOT: {
+      int input_slot_index = iterator->Next();
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(input_slot_index);
+      intptr_t input_value = input_->GetFrameSlot(input_offset);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- 0x%08" V8PRIxPTR
+               " ; [sp + %d] ",
+               object_index, field_index, input_value, input_offset);
+        reinterpret_cast<Object*>(input_value)->ShortPrint();
+        PrintF("\n");
+      }
+      AddObjectTaggedValue(input_value);
+      return;
+    }
+
+    case Translation::INT32_STACK_SLOT: {
+      int input_slot_index = iterator->Next();
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(input_slot_index);
+      intptr_t value = input_->GetFrameSlot(input_offset);
+      bool is_smi = Smi::IsValid(value);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %" V8PRIdPTR
+               " ; [sp + %d] (%s)\n",
+               object_index, field_index, value, input_offset,
+               TraceValueType(is_smi, false));
+      }
+      if (is_smi) {
+        intptr_t tagged_value =
+            reinterpret_cast<intptr_t>(Smi::FromInt(static_cast<int>(value)));
+        AddObjectTaggedValue(tagged_value);
+      } else {
+        AddObjectDoubleValue(static_cast<double>(static_cast<int32_t>(value)));
+      }
+      return;
+    }
+
+    case Translation::UINT32_STACK_SLOT: {
+      int input_slot_index = iterator->Next();
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(input_slot_index);
+      uintptr_t value =
+          static_cast<uintptr_t>(input_->GetFrameSlot(input_offset));
+      bool is_smi = (value <= static_cast<uintptr_t>(Smi::kMaxValue));
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %" V8PRIuPTR
+               " ; [sp + %d] (uint32 %s)\n",
+               object_index, field_index, value, input_offset,
+               TraceValueType(is_smi, false));
+      }
+      if (is_smi) {
+        intptr_t tagged_value =
+            reinterpret_cast<intptr_t>(Smi::FromInt(static_cast<int>(value)));
+        AddObjectTaggedValue(tagged_value);
+      } else {
+        AddObjectDoubleValue(static_cast<double>(static_cast<uint32_t>(value)));
+      }
+      return;
+    }
+
+    case Translation::DOUBLE_STACK_SLOT: {
+      int input_slot_index = iterator->Next();
+      unsigned input_offset = input_->GetOffsetFromSlotIndex(input_slot_index);
+      double value = input_->GetDoubleFrameSlot(input_offset);
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- %e ; [sp + %d]\n",
+               object_index, field_index, value, input_offset);
+      }
+      AddObjectDoubleValue(value);
+      return;
+    }
+
+    case Translation::LITERAL: {
+      Object* literal = ComputeLiteral(iterator->Next());
+      if (trace_) {
+        PrintF("      object #%d (field #%d) <- ", object_index, field_index);
+        literal->ShortPrint();
+        PrintF(" ; literal\n");
+      }
+      intptr_t value = reinterpret_cast<intptr_t>(literal);
+      AddObjectTaggedValue(value);
+      return;
+    }
   }
 }
 
@@ -2209,6 +2559,12 @@ bool Deoptimizer::DoOsrTranslateCommand(TranslationIterator* iterator,
       UNREACHABLE();
       return false;
     }
+
+    case Translation::CAPTURED_OBJECT:
+    case Translation::DUPLICATED_OBJECT:
+      // Unoptimized frames never contain captured objects.
+      UNREACHABLE();
+      return false;
   }
 
   if (!duplicate) *input_offset -= kPointerSize;
@@ -2377,8 +2733,51 @@ void Deoptimizer::AddArgumentsObjectValue(intptr_t value) {
 }
 
 
+void Deoptimizer::AddObjectStart(intptr_t slot_address, int length) {
+  ObjectMaterializationDescriptor object_desc(
+      reinterpret_cast<Address>(slot_address), length, -1);
+  deferred_objects_.Add(object_desc);
+}
+
+
+void Deoptimizer::AddObjectDuplication(intptr_t slot_address,
+                                       int object_index) {
+  ObjectMaterializationDescriptor object_desc(
+      reinterpret_cast<Address>(slot_address), 0, object_index);
+  deferred_objects_.Add(object_desc);
+}
+
+
+void Deoptimizer::AddObjectTaggedValue(intptr_t value) {
+  deferred_objects_tagged_values_.Add(reinterpret_cast<Object*>(value));
+}
+
+
+void Deoptimizer::AddObjectDoubleValue(double value) {
+  // A GC-safe placeholder that is replaced by the materialized heap number.
+  deferred_objects_tagged_values_.Add(Smi::FromInt(0));
+  HeapNumberMaterializationDescriptor<int> value_desc(
+      deferred_objects_tagged_values_.length() - 1, value);
+  deferred_objects_double_values_.Add(value_desc);
+}
+
+
+int Deoptimizer::FindCapturedObjectForSlot(intptr_t slot_address) {
+  // Duplicates are numbered by the captured objects they refer to.
+  int object_index = 0;
+  for (int i = 0; i < deferred_objects_.length(); i++) {
+    ObjectMaterializationDescriptor d = deferred_objects_[i];
+    if (d.slot_address() == reinterpret_cast<Address>(slot_address)) {
+      return d.is_duplicate() ? d.duplicate_object() : object_index;
+    }
+    if (!d.is_duplicate()) object_index++;
+  }
+  return -1;
+}
+
+
 void Deoptimizer::AddDoubleValue(intptr_t slot_address, double value) {
-  HeapNumberMaterializationDescriptor value_desc(
+  HeapNumberMaterializationDescriptor<Address> value_desc(
       reinterpret_cast<Address>(slot_address), value);
   deferred_heap_numbers_.Add(value_desc);
 }
@@ -2661,6 +3060,18 @@ void Translation::StoreArgumentsObject(bool args_known,
 }
 
 
+void Translation::BeginCapturedObject(int length) {
+  buffer_->Add(CAPTURED_OBJECT, zone());
+  buffer_->Add(length, zone());
+}
+
+
+void Translation::DuplicateObject(int object_index) {
+  buffer_->Add(DUPLICATED_OBJECT, zone());
+  buffer_->Add(object_index, zone());
+}
+
+
 void Translation::MarkDuplicate() {
   buffer_->Add(DUPLICATE, zone());
 }
@@ -2682,6 +3093,8 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case DOUBLE_STACK_SLOT:
     case LITERAL:
     case COMPILED_STUB_FRAME:
+    case CAPTURED_OBJECT:
+    case DUPLICATED_OBJECT:
       return 1;
     case BEGIN:
     case ARGUMENTS_ADAPTOR_FRAME:
@@ -2734,6 +3147,10 @@ const char* Translation::StringFor(Opcode opcode) {
       return "LITERAL";
     case ARGUMENTS_OBJECT:
       return "ARGUMENTS_OBJECT";
+    case CAPTURED_OBJECT:
+      return "CAPTURED_OBJECT";
+    case DUPLICATED_OBJECT:
+      return "DUPLICATED_OBJECT";
     case DUPLICATE:
       return "DUPLICATE";
   }
@@ -2764,9 +3181,11 @@ DeoptimizingCodeListNode::~DeoptimizingCodeListNode() {
 // We can't intermix stack decoding and allocations because
 // deoptimization infrastracture is not GC safe.
 // Thus we build a temporary structure in malloced space.
-SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
-                                            DeoptimizationInputData* data,
-                                            JavaScriptFrame* frame) {
+SlotRef SlotRef::ComputeSlotForNextArgument(
+    TranslationIterator* iterator,
+    DeoptimizationInputData* data,
+    JavaScriptFrame* frame,
+    List<TranslationIterator>* captured_objects) {
   Translation::Opcode opcode =
       static_cast<Translation::Opcode>(iterator->Next());
 
@@ -2784,6 +3203,19 @@ SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
       // This can be only emitted for local slots not for argument slots.
       break;
 
+    case Translation::CAPTURED_OBJECT:
+      // Remember where the fields start so that duplicates can be resolved.
+      captured_objects->Add(*iterator);
+      return ComputeSlotForCapturedObject(
+          iterator, data, frame, captured_objects);
+
+    case Translation::DUPLICATED_OBJECT: {
+      // Duplicates get an object of their own, identity is not preserved.
+      TranslationIterator object_it = captured_objects->at(iterator->Next());
+      return ComputeSlotForCapturedObject(
+          &object_it, data, frame, captured_objects);
+    }
+
     case Translation::REGISTER:
     case Translation::INT32_REGISTER:
     case Translation::UINT32_REGISTER:
@@ -2834,19 +3266,77 @@ SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
 }
 
 
-void SlotRef::ComputeSlotsForArguments(Vector<SlotRef>* args_slots,
-                                       TranslationIterator* it,
-                                       DeoptimizationInputData* data,
-                                       JavaScriptFrame* frame) {
+SlotRef SlotRef::ComputeSlotForCapturedObject(
+    TranslationIterator* iterator,
+    DeoptimizationInputData* data,
+    JavaScriptFrame* frame,
+    List<TranslationIterator>* captured_objects) {
+  int length = iterator->Next();
+  Vector<SlotRef> fields = Vector<SlotRef>::New(length);
+  for (int i = 0; i < length; ++i) {
+    fields[i] = ComputeSlotForNextArgument(
+        iterator, data, frame, captured_objects);
+  }
+  return SlotRef(fields);
+}
+
+
+Handle<Object> SlotRef::GetDeferredObject(Isolate* isolate) {
+  // The fields are map, properties, elements and the in-object properties.
+  int length = fields_.length();
+  Handle<Map> map = Handle<Map>::cast(fields_[0].GetValue(isolate));
+  ASSERT(map->instance_size() == length * kPointerSize);
+  Handle<JSObject> object = isolate->factory()->NewJSObjectFromMap(map);
+  Handle<Object> properties = fields_[1].GetValue(isolate);
+  object->set_properties(FixedArray::cast(*properties));
+  Handle<Object> elements = fields_[2].GetValue(isolate);
+  object->set_elements(FixedArrayBase::cast(*elements));
+  const int header_length = JSObject::kHeaderSize / kPointerSize;
+  for (int i = header_length; i < length; ++i) {
+    Handle<Object> value = fields_[i].GetValue(isolate);
+    object->InObjectPropertyAtPut(map->inobject_properties() - (length - i),
+                                  *value);
+  }
+  return object;
+}
+
+
+void SlotRef::DisposeSlotMapping(Vector<SlotRef> slots) {
+  for (int i = 0; i < slots.length(); ++i) {
+    if (slots[i].representation_ == DEFERRED_OBJECT) {
+      DisposeSlotMapping(slots[i].fields_);
+    }
+  }
+  slots.Dispose();
+}
+
+
+void SlotRef::ComputeSlotsForArguments(
+    Vector<SlotRef>* args_slots,
+    TranslationIterator* it,
+    DeoptimizationInputData* data,
+    JavaScriptFrame* frame,
+    List<TranslationIterator>* captured_objects) {
   // Process the translation commands for the arguments.
 
-  // Skip the translation command for the receiver.
-  it->Skip(Translation::NumberOfOperandsFor(
-      static_cast<Translation::Opcode>(it->Next())));
+  // Skip the translation command for the receiver, including the fields of
+  // a captured receiver.
+  Translation::Opcode opcode = static_cast<Translation::Opcode>(it->Next());
+  if (opcode == Translation::CAPTURED_OBJECT) {
+    captured_objects->Add(*it);
+    int length = it->Next();
+    for (int i = 0; i < length; ++i) {
+      it->Skip(Translation::NumberOfOperandsFor(
+          static_cast<Translation::Opcode>(it->Next())));
+    }
+  } else {
+    it->Skip(Translation::NumberOfOperandsFor(opcode));
+  }
 
   // Compute slots for arguments.
   for (int i = 0; i < args_slots->length(); ++i) {
-    (*args_slots)[i] = ComputeSlotForNextArgument(it, data, frame);
+    (*args_slots)[i] =
+        ComputeSlotForNextArgument(it, data, frame, captured_objects);
   }
 }
 
@@ -2868,8 +3358,13 @@ Vector<SlotRef> SlotRef::ComputeSlotMappingForArguments(
   USE(jsframe_count);
   ASSERT(jsframe_count > inlined_jsframe_index);
   int jsframes_to_skip = inlined_jsframe_index;
+  // Positions of the captured objects seen so far, for resolving duplicates.
+  List<TranslationIterator> captured_objects;
   while (true) {
     opcode = static_cast<Translation::Opcode>(it.Next());
+    if (opcode == Translation::CAPTURED_OBJECT) {
+      captured_objects.Add(it);
+    }
     if (opcode == Translation::ARGUMENTS_ADAPTOR_FRAME) {
       if (jsframes_to_skip == 0) {
         ASSERT(Translation::NumberOfOperandsFor(opcode) == 2);
@@ -2881,7 +3376,8 @@ Vector<SlotRef> SlotRef::ComputeSlotMappingForArguments(
         // inlined function in question.  Number of arguments is height - 1.
         Vector<SlotRef> args_slots =
             Vector<SlotRef>::New(height - 1);  // Minus receiver.
-        ComputeSlotsForArguments(&args_slots, &it, data, frame);
+        ComputeSlotsForArguments(&args_slots, &it, data, frame,
+                                 &captured_objects);
         return args_slots;
       }
     } else if (opcode == Translation::JS_FRAME) {
@@ -2895,7 +3391,8 @@ Vector<SlotRef> SlotRef::ComputeSlotMappingForArguments(
         // format parameter count.
         Vector<SlotRef> args_slots =
             Vector<SlotRef>::New(formal_parameter_count);
-        ComputeSlotsForArguments(&args_slots, &it, data, frame);
+        ComputeSlotsForArguments(&args_slots, &it, data, frame,
+                                 &captured_objects);
         return args_slots;
       }
       jsframes_to_skip--;
@@ -43,17 +43,41 @@ class TranslationIterator;
 class DeoptimizingCodeListNode;
 class DeoptimizedFrameInfo;
 
+template<typename T>
 class HeapNumberMaterializationDescriptor BASE_EMBEDDED {
  public:
-  HeapNumberMaterializationDescriptor(Address slot_address, double val)
-      : slot_address_(slot_address), val_(val) { }
+  HeapNumberMaterializationDescriptor(T destination, double value)
+      : destination_(destination), value_(value) { }
 
+  T destination() const { return destination_; }
+  double value() const { return value_; }
+
+ private:
+  T destination_;
+  double value_;
+};
+
+
+class ObjectMaterializationDescriptor BASE_EMBEDDED {
+ public:
+  ObjectMaterializationDescriptor(Address slot_address,
+                                  int length,
+                                  int duplicate_object)
+      : slot_address_(slot_address),
+        object_length_(length),
+        duplicate_object_(duplicate_object) { }
+
+  // The slot address may be NULL for objects that are materialized without
+  // being stored in an output frame slot.
   Address slot_address() const { return slot_address_; }
-  double value() const { return val_; }
+  int object_length() const { return object_length_; }
+  int duplicate_object() const { return duplicate_object_; }
+  bool is_duplicate() const { return duplicate_object_ >= 0; }
 
  private:
   Address slot_address_;
-  double val_;
+  int object_length_;
+  int duplicate_object_;
 };
 
 
@@ -234,7 +258,7 @@ class Deoptimizer : public Malloced {
 
   void MaterializeHeapObjects(JavaScriptFrameIterator* it);
 #ifdef ENABLE_DEBUGGER_SUPPORT
-  void MaterializeHeapNumbersForDebuggerInspectableFrame(
+  void MaterializeHeapObjectsForDebuggerInspectableFrame(
       Address parameters_top,
       uint32_t parameters_size,
       Address expressions_top,
@@ -361,6 +385,12 @@ class Deoptimizer : public Malloced {
       unsigned output_offset,
       DeoptimizerTranslatedValueType value_type = TRANSLATED_VALUE_IS_TAGGED);
 
+  // Translate the field values of a captured object into the list of deferred
+  // object values.
+  void DoTranslateObject(TranslationIterator* iterator,
+                         int object_index,
+                         int field_index);
+
   // Translate a command for OSR.  Updates the input offset to be used for
   // the next command.  Returns false if translation of the command failed
   // (e.g., a number conversion failed) and may or may not have updated the
@@ -378,8 +408,36 @@ class Deoptimizer : public Malloced {
 
   void AddArgumentsObject(intptr_t slot_address, int argc);
   void AddArgumentsObjectValue(intptr_t value);
+  void AddObjectStart(intptr_t slot_address, int length);
+  void AddObjectDuplication(intptr_t slot_address, int object_index);
+  void AddObjectTaggedValue(intptr_t value);
+  void AddObjectDoubleValue(double value);
   void AddDoubleValue(intptr_t slot_address, double value);
 
+  // Returns the index of the captured object that is about to be stored into
+  // the given slot, or -1 if the slot does not hold a captured object.
+  int FindCapturedObjectForSlot(intptr_t slot_address);
+
+  // Allocates the objects captured by escape analysis from their handlified
+  // field values. The result holds one object per entry of deferred_objects_,
+  // so a duplicated object appears once for each slot it is stored into.
+  void MaterializeCapturedObjects(List<Handle<Object> >* object_values,
+                                  List<Handle<JSObject> >* objects);
+
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // Stores a value materialized for the given output frame slot into the
+  // parameter or expression of the inspected frame it belongs to. Returns
+  // false if the slot belongs to another frame.
+  static bool SetDebuggerInspectableFrameSlot(DeoptimizedFrameInfo* info,
+                                              Address slot,
+                                              Address parameters_top,
+                                              Address parameters_bottom,
+                                              Address expressions_top,
+                                              Address expressions_bottom,
+                                              Object* value,
+                                              bool trace);
+#endif
+
   static void GenerateDeoptimizationEntries(
       MacroAssembler* masm, int count, BailoutType type);
 
@@ -430,7 +488,14 @@ class Deoptimizer : public Malloced {
 
   List<Object*> deferred_arguments_objects_values_;
   List<ArgumentsObjectMaterializationDescriptor> deferred_arguments_objects_;
-  List<HeapNumberMaterializationDescriptor> deferred_heap_numbers_;
+  List<HeapNumberMaterializationDescriptor<Address> > deferred_heap_numbers_;
+
+  // Captured objects in the order of the translation. Duplicates refer to the
+  // index of the original among the non-duplicate entries.
+  List<ObjectMaterializationDescriptor> deferred_objects_;
+  List<Object*> deferred_objects_tagged_values_;
+  List<HeapNumberMaterializationDescriptor<int> >
+      deferred_objects_double_values_;
 
   bool trace_;
 
@@ -699,6 +764,10 @@ class Translation BASE_EMBEDDED {
     DOUBLE_STACK_SLOT,
     LITERAL,
     ARGUMENTS_OBJECT,
+    // A captured object followed by the commands for its fields.
+    CAPTURED_OBJECT,
+    // A reference to a captured object that was described earlier.
+    DUPLICATED_OBJECT,
 
     // A prefix indicating that the next command is a duplicate of the one
     // that follows it.
@@ -734,6 +803,8 @@ class Translation BASE_EMBEDDED {
   void StoreDoubleStackSlot(int index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject(bool args_known, int args_index, int args_length);
+  void BeginCapturedObject(int length);
+  void DuplicateObject(int object_index);
   void MarkDuplicate();
 
   Zone* zone() const { return zone_; }
@@ -782,7 +853,8 @@ class SlotRef BASE_EMBEDDED {
     INT32,
     UINT32,
     DOUBLE,
-    LITERAL
+    LITERAL,
+    DEFERRED_OBJECT
   };
 
   SlotRef()
@@ -794,6 +866,10 @@ class SlotRef BASE_EMBEDDED {
   SlotRef(Isolate* isolate, Object* literal)
       : literal_(literal, isolate), representation_(LITERAL) { }
 
+  // A captured object, materialized from the given field slots on demand.
+  explicit SlotRef(Vector<SlotRef> fields)
+      : addr_(NULL), representation_(DEFERRED_OBJECT), fields_(fields) { }
+
   Handle<Object> GetValue(Isolate* isolate) {
     switch (representation_) {
       case TAGGED:
@@ -825,6 +901,9 @@ class SlotRef BASE_EMBEDDED {
       case LITERAL:
         return literal_;
 
+      case DEFERRED_OBJECT:
+        return GetDeferredObject(isolate);
+
       default:
         UNREACHABLE();
         return Handle<Object>::null();
@@ -836,10 +915,17 @@ class SlotRef BASE_EMBEDDED {
       int inlined_frame_index,
       int formal_parameter_count);
 
+  // Releases a slot mapping together with the field slots of any captured
+  // objects it contains.
+  static void DisposeSlotMapping(Vector<SlotRef> slots);
+
  private:
   Address addr_;
   Handle<Object> literal_;
   SlotRepresentation representation_;
+  Vector<SlotRef> fields_;
+
+  Handle<Object> GetDeferredObject(Isolate* isolate);
 
   static Address SlotAddress(JavaScriptFrame* frame, int slot_index) {
     if (slot_index >= 0) {
@@ -851,15 +937,24 @@ class SlotRef BASE_EMBEDDED {
     }
   }
 
-  static SlotRef ComputeSlotForNextArgument(TranslationIterator* iterator,
-                                            DeoptimizationInputData* data,
-                                            JavaScriptFrame* frame);
+  static SlotRef ComputeSlotForNextArgument(
+      TranslationIterator* iterator,
+      DeoptimizationInputData* data,
+      JavaScriptFrame* frame,
+      List<TranslationIterator>* captured_objects);
+
+  static SlotRef ComputeSlotForCapturedObject(
+      TranslationIterator* iterator,
+      DeoptimizationInputData* data,
+      JavaScriptFrame* frame,
+      List<TranslationIterator>* captured_objects);
 
   static void ComputeSlotsForArguments(
       Vector<SlotRef>* args_slots,
       TranslationIterator* iterator,
       DeoptimizationInputData* data,
-      JavaScriptFrame* frame);
+      JavaScriptFrame* frame,
+      List<TranslationIterator>* captured_objects);
 };
 
 
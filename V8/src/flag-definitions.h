@@ -209,6 +209,12 @@ DEFINE_string(hydrogen_filter, "", "optimization filter")
 DEFINE_bool(use_range, true, "use hydrogen range analysis")
 DEFINE_bool(use_gvn, true, "use hydrogen global value numbering")
 DEFINE_bool(use_canonicalizing, true, "use hydrogen instruction canonicalizing")
+DEFINE_bool(use_escape_analysis, false,
+            "use hydrogen escape analysis (stack traces report undefined as "
+            "the receiver of inlined constructors whose object is not "
+            "allocated)")
+DEFINE_bool(use_load_elimination, false,
+            "use hydrogen load/store and map check elimination")
 DEFINE_bool(use_inlining, true, "use function inlining")
 DEFINE_int(max_inlined_source_size, 600,
            "maximum source size in bytes considered for a single inlining")
@@ -229,6 +235,8 @@ DEFINE_bool(trace_alloc, false, "trace register allocator")
 DEFINE_bool(trace_all_uses, false, "trace all use positions")
 DEFINE_bool(trace_range, false, "trace range analysis")
 DEFINE_bool(trace_gvn, false, "trace global value numbering")
+DEFINE_bool(trace_escape_analysis, false, "trace hydrogen escape analysis")
+DEFINE_bool(trace_load_elimination, false, "trace load/store elimination")
 DEFINE_bool(trace_representation, false, "trace representation types")
 DEFINE_bool(trace_track_allocation_sites, false,
             "trace the tracking of allocation sites")
@@ -249,6 +257,10 @@ DEFINE_bool(use_osr, true, "use on-stack replacement")
 DEFINE_bool(idefs, false, "use informative definitions")
 DEFINE_bool(array_bounds_checks_elimination, true,
             "perform array bounds checks elimination")
+DEFINE_bool(array_bounds_checks_hoisting, false,
+            "hoist array bounds checks of counting loops to the pre-header")
+DEFINE_bool(trace_bounds_checks_hoisting, false,
+            "trace hoisting of array bounds checks")
 DEFINE_bool(array_index_dehoisting, true,
             "perform array index dehoisting")
 DEFINE_bool(dead_code_elimination, true, "use dead code elimination")
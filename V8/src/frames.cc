@@ -968,15 +968,27 @@ void OptimizedFrame::Summarize(List<FrameSummary>* frames) {
 
       // The translation commands are ordered and the receiver is always
       // at the first position. Since we are always at a call when we need
-      // to construct a stack trace, the receiver is always in a stack slot.
+      // to construct a stack trace, the receiver is always in a stack slot
+      // unless it was replaced by escape analysis.
       opcode = static_cast<Translation::Opcode>(it.Next());
       ASSERT(opcode == Translation::STACK_SLOT ||
-             opcode == Translation::LITERAL);
+             opcode == Translation::LITERAL ||
+             opcode == Translation::CAPTURED_OBJECT ||
+             opcode == Translation::DUPLICATED_OBJECT);
       int index = it.Next();
 
       // Get the correct receiver in the optimized frame.
       Object* receiver = NULL;
-      if (opcode == Translation::LITERAL) {
+      if (opcode == Translation::CAPTURED_OBJECT ||
+          opcode == Translation::DUPLICATED_OBJECT) {
+        // The receiver was never allocated, and the summary cannot allocate
+        // it since it hands out raw pointers, so the receiver of such an
+        // inlined constructor is reported as undefined. The debugger gets
+        // the materialized object from DeoptimizedFrameInfo instead. The
+        // commands for the fields of a captured object are skipped by the
+        // generic case below.
+        receiver = isolate()->heap()->undefined_value();
+      } else if (opcode == Translation::LITERAL) {
         receiver = data->LiteralArray()->get(index);
       } else {
         // Positive index means the value is spilled to the locals
@@ -502,6 +502,9 @@ MaybeObject* Heap::PrepareForCompare(String* str) {
   static const int kFlattenLongThreshold = 16*KB;
 
   const int length = str->length();
+  if (!str->IsFlat()) {
+    isolate()->counters()->string_flatten_compare()->Increment(length);
+  }
   MaybeObject* obj = str->TryFlatten();
   if (length <= kMaxAlwaysFlattenLength ||
       unflattened_strings_length_ >= kFlattenLongThreshold) {
@@ -156,6 +156,10 @@ Heap::Heap()
       ms_count_at_last_idle_notification_(0),
       gc_count_at_last_idle_gc_(0),
       scavenges_since_last_idle_round_(kIdleScavengeThreshold),
+      idle_marking_speed_in_bytes_per_ms_(0),
+      idle_sweeping_speed_in_bytes_per_ms_(0),
+      mark_compact_speed_in_bytes_per_ms_(0),
+      final_incremental_mark_compact_speed_in_bytes_per_ms_(0),
       gcs_since_last_deopt_(0),
 #ifdef VERIFY_HEAP
       no_weak_embedded_maps_verification_scope_depth_(0),
@@ -182,6 +186,7 @@ Heap::Heap()
 
   memset(roots_, 0, sizeof(roots_[0]) * kRootListLength);
   native_contexts_list_ = NULL;
+  array_buffers_list_ = NULL;
   mark_compact_collector_.heap_ = this;
   external_string_table_.heap_ = this;
   // Put a dummy entry in the remembered pages so we can find the list the
@@ -586,7 +591,8 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
   // hope that eventually there will be no weak callbacks invocations.
   // Therefore stop recollecting after several attempts.
   mark_compact_collector()->SetFlags(kMakeHeapIterableMask |
-                                     kReduceMemoryFootprintMask);
+                                     kReduceMemoryFootprintMask |
+                                     kCompactSparsePagesMask);
   isolate_->compilation_cache()->Clear();
   const int kMaxNumberOfAttempts = 7;
   for (int attempt = 0; attempt < kMaxNumberOfAttempts; attempt++) {
@@ -598,6 +604,18 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
   new_space_.Shrink();
   UncommitFromSpace();
   incremental_marking()->UncommitMarkingDeque();
+  store_buffer()->Shrink();
+}
+
+
+void Heap::ReduceMemoryFootprint(const char* gc_reason) {
+  CollectAllGarbage(kReduceMemoryFootprintMask | kCompactSparsePagesMask,
+                    gc_reason);
+  // The full GC has emptied new space, so it shrinks to its initial size.
+  new_space_.Shrink();
+  UncommitFromSpace();
+  incremental_marking()->UncommitMarkingDeque();
+  store_buffer()->Shrink();
 }
 
 
@@ -1041,6 +1059,11 @@ void Heap::MarkCompact(GCTracer* tracer) {
   gc_state_ = MARK_COMPACT;
   LOG(isolate_, ResourceEvent("markcompact", "begin"));
 
+  // Measure the collection for idle-time scheduling.
+  bool finishes_incremental_marking = !incremental_marking()->IsStopped();
+  intptr_t size_of_objects = SizeOfObjects();
+  double start = OS::TimeCurrentMillis();
+
   mark_compact_collector_.Prepare(tracer);
 
   ms_count_++;
@@ -1050,6 +1073,12 @@ void Heap::MarkCompact(GCTracer* tracer) {
 
   mark_compact_collector_.CollectGarbage();
 
+  UpdateSpeed(finishes_incremental_marking
+                  ? &final_incremental_mark_compact_speed_in_bytes_per_ms_
+                  : &mark_compact_speed_in_bytes_per_ms_,
+              size_of_objects,
+              OS::TimeCurrentMillis() - start);
+
   LOG(isolate_, ResourceEvent("markcompact", "end"));
 
   gc_state_ = NOT_IN_GC;
@@ -1070,6 +1099,7 @@ void Heap::MarkCompactPrologue() {
   isolate_->descriptor_lookup_cache()->Clear();
   RegExpResultsCache::Clear(string_split_cache());
   RegExpResultsCache::Clear(regexp_multiple_cache());
+  StringBuilderCache::Clear(string_builder_cache());
 
   isolate_->compilation_cache()->MarkCompactPrologue();
 
@@ -1538,6 +1568,111 @@ static Object* ProcessFunctionWeakReferences(Heap* heap,
 }
 
 
+static Object* ProcessTypedArrayWeakReferences(Heap* heap,
+                                               Object* typed_array,
+                                               WeakObjectRetainer* retainer,
+                                               bool record_slots) {
+  Object* undefined = heap->undefined_value();
+  Object* head = undefined;
+  JSTypedArray* tail = NULL;
+  Object* candidate = typed_array;
+  while (candidate != undefined) {
+    // Check whether to keep the candidate in the list.
+    JSTypedArray* candidate_view = reinterpret_cast<JSTypedArray*>(candidate);
+    Object* retain = retainer->RetainAs(candidate);
+    if (retain != NULL) {
+      if (head == undefined) {
+        // First element in the list.
+        head = retain;
+      } else {
+        // Subsequent elements in the list.
+        ASSERT(tail != NULL);
+        tail->set_weak_next(retain);
+        if (record_slots) {
+          Object** next_view =
+              HeapObject::RawField(tail, JSTypedArray::kWeakNextOffset);
+          heap->mark_compact_collector()->RecordSlot(
+              next_view, next_view, retain);
+        }
+      }
+      // Retained typed array is new tail.
+      candidate_view = reinterpret_cast<JSTypedArray*>(retain);
+      tail = candidate_view;
+    }
+
+    // Move to next element in the list.
+    candidate = candidate_view->weak_next();
+  }
+
+  // Terminate the list if there is one or more elements.
+  if (tail != NULL) {
+    tail->set_weak_next(undefined);
+  }
+
+  return head;
+}
+
+
+static Object* ProcessArrayBufferWeakReferences(Heap* heap,
+                                                Object* array_buffer,
+                                                WeakObjectRetainer* retainer,
+                                                bool record_slots) {
+  Object* undefined = heap->undefined_value();
+  Object* head = undefined;
+  JSArrayBuffer* tail = NULL;
+  Object* candidate = array_buffer;
+  while (candidate != undefined) {
+    // Check whether to keep the candidate in the list.
+    JSArrayBuffer* candidate_buffer =
+        reinterpret_cast<JSArrayBuffer*>(candidate);
+    Object* retain = retainer->RetainAs(candidate);
+    if (retain != NULL) {
+      if (head == undefined) {
+        // First element in the list.
+        head = retain;
+      } else {
+        // Subsequent elements in the list.
+        ASSERT(tail != NULL);
+        tail->set_weak_next(retain);
+        if (record_slots) {
+          Object** next_buffer =
+              HeapObject::RawField(tail, JSArrayBuffer::kWeakNextOffset);
+          heap->mark_compact_collector()->RecordSlot(
+              next_buffer, next_buffer, retain);
+        }
+      }
+      // Retained array buffer is new tail.
+      candidate_buffer = reinterpret_cast<JSArrayBuffer*>(retain);
+      tail = candidate_buffer;
+
+      // Process the weak list of views of the array buffer.
+      Object* view_list_head =
+          ProcessTypedArrayWeakReferences(heap,
+                                          candidate_buffer->weak_first_view(),
+                                          retainer,
+                                          record_slots);
+      candidate_buffer->set_weak_first_view(view_list_head);
+      if (record_slots) {
+        Object** first_view =
+            HeapObject::RawField(tail, JSArrayBuffer::kWeakFirstViewOffset);
+        heap->mark_compact_collector()->RecordSlot(
+            first_view, first_view, view_list_head);
+      }
+    }
+
+    // Move to next element in the list.
+    candidate = candidate_buffer->weak_next();
+  }
+
+  // Terminate the list if there is one or more elements.
+  if (tail != NULL) {
+    tail->set_weak_next(undefined);
+  }
+
+  return head;
+}
+
+
 void Heap::ProcessWeakReferences(WeakObjectRetainer* retainer) {
   Object* undefined = undefined_value();
   Object* head = undefined;
@@ -1616,6 +1751,12 @@ void Heap::ProcessWeakReferences(WeakObjectRetainer* retainer) {
 
   // Update the head of the list of contexts.
   native_contexts_list_ = head;
+
+  array_buffers_list_ =
+      ProcessArrayBufferWeakReferences(this,
+                                       array_buffers_list_,
+                                       retainer,
+                                       record_slots);
 }
 
 
@@ -1798,6 +1939,14 @@ class ScavengingVisitor : public StaticVisitorBase {
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
                     Visit);
 
+    table_.Register(kVisitJSArrayBuffer,
+                    &ObjectEvacuationStrategy<POINTER_OBJECT>::
+                    Visit);
+
+    table_.Register(kVisitJSTypedArray,
+                    &ObjectEvacuationStrategy<POINTER_OBJECT>::
+                    Visit);
+
     if (marks_handling == IGNORE_MARKS) {
       table_.Register(kVisitJSFunction,
                       &ObjectEvacuationStrategy<POINTER_OBJECT>::
@@ -2949,6 +3098,12 @@ bool Heap::CreateInitialObjects() {
   }
   set_regexp_multiple_cache(FixedArray::cast(obj));
 
+  { MaybeObject* maybe_obj = AllocateFixedArray(
+      StringBuilderCache::kStringBuilderCacheSize, TENURED);
+    if (!maybe_obj->ToObject(&obj)) return false;
+  }
+  set_string_builder_cache(FixedArray::cast(obj));
+
   // Allocate cache for external strings pointing to native source code.
   { MaybeObject* maybe_obj = AllocateFixedArray(Natives::GetBuiltinsCount());
     if (!maybe_obj->ToObject(&obj)) return false;
@@ -3109,6 +3264,47 @@ void RegExpResultsCache::Clear(FixedArray* cache) {
 }
 
 
+int StringBuilderCache::Lookup(Heap* heap, String* store) {
+  FixedArray* cache = heap->string_builder_cache();
+  for (int i = 0; i < kStringBuilderCacheSize;
+       i += kArrayEntriesPerCacheEntry) {
+    if (cache->get(i + kStoreOffset) == store) {
+      return Smi::cast(cache->get(i + kUsedLengthOffset))->value();
+    }
+  }
+  return -1;
+}
+
+
+void StringBuilderCache::Enter(Heap* heap, String* store, int used_length) {
+  FixedArray* cache = heap->string_builder_cache();
+  // Move the entries in front of |store|, or all of them if |store| is not
+  // in the cache, one entry back so that the oldest entry falls out.
+  int index = kStringBuilderCacheSize - kArrayEntriesPerCacheEntry;
+  for (int i = 0; i < kStringBuilderCacheSize;
+       i += kArrayEntriesPerCacheEntry) {
+    if (cache->get(i + kStoreOffset) == store) {
+      index = i;
+      break;
+    }
+  }
+  for (int i = index; i > 0; i -= kArrayEntriesPerCacheEntry) {
+    int from = i - kArrayEntriesPerCacheEntry;
+    cache->set(i + kStoreOffset, cache->get(from + kStoreOffset));
+    cache->set(i + kUsedLengthOffset, cache->get(from + kUsedLengthOffset));
+  }
+  cache->set(kStoreOffset, store);
+  cache->set(kUsedLengthOffset, Smi::FromInt(used_length));
+}
+
+
+void StringBuilderCache::Clear(FixedArray* cache) {
+  for (int i = 0; i < kStringBuilderCacheSize; i++) {
+    cache->set(i, Smi::FromInt(0));
+  }
+}
+
+
 MaybeObject* Heap::AllocateInitialNumberStringCache() {
   MaybeObject* maybe_obj =
       AllocateFixedArray(kInitialNumberStringCacheSize * 2, TENURED);
@@ -5758,18 +5954,23 @@ void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size) {
                               IncrementalMarking::NO_GC_VIA_STACK_GUARD);
 
   if (incremental_marking()->IsComplete()) {
-    bool uncommit = false;
-    if (gc_count_at_last_idle_gc_ == gc_count_) {
-      // No GC since the last full GC, the mutator is probably not active.
-      isolate_->compilation_cache()->Clear();
-      uncommit = true;
-    }
-    CollectAllGarbage(kNoGCFlags, "idle notification: finalize incremental");
-    gc_count_at_last_idle_gc_ = gc_count_;
-    if (uncommit) {
-      new_space_.Shrink();
-      UncommitFromSpace();
-    }
+    FinalizeIdleIncrementalMarking();
+  }
+}
+
+
+void Heap::FinalizeIdleIncrementalMarking() {
+  bool uncommit = false;
+  if (gc_count_at_last_idle_gc_ == gc_count_) {
+    // No GC since the last full GC, the mutator is probably not active.
+    isolate_->compilation_cache()->Clear();
+    uncommit = true;
+  }
+  CollectAllGarbage(kNoGCFlags, "idle notification: finalize incremental");
+  gc_count_at_last_idle_gc_ = gc_count_;
+  if (uncommit) {
+    new_space_.Shrink();
+    UncommitFromSpace();
   }
 }
 
@@ -5832,6 +6033,35 @@ bool Heap::IdleNotification(int hint) {
     }
   }
 
+  int remaining_mark_sweeps;
+  if (IdleRoundIsOver(&remaining_mark_sweeps)) return true;
+
+  if (incremental_marking()->IsStopped()) {
+    // If there are no more than two GCs left in this idle round and we are
+    // allowed to do a full GC, then make those GCs full in order to compact
+    // the code space.
+    // TODO(ulan): Once we enable code compaction for incremental marking,
+    // we can get rid of this special case and always start incremental marking.
+    if (remaining_mark_sweeps <= 2 && hint >= kMinHintForFullGC) {
+      if (remaining_mark_sweeps == 1) {
+        // The isolate is going idle, give back as much memory as possible.
+        ReduceMemoryFootprint("idle notification: finalize idle round");
+      } else {
+        CollectAllGarbage(kReduceMemoryFootprintMask,
+                          "idle notification: finalize idle round");
+      }
+    } else {
+      incremental_marking()->Start();
+    }
+  }
+  if (!incremental_marking()->IsStopped()) {
+    AdvanceIdleIncrementalMarking(step_size);
+  }
+  return false;
+}
+
+
+bool Heap::IdleRoundIsOver(int* remaining_mark_sweeps) {
   if (mark_sweeps_since_idle_round_started_ >= kMaxMarkSweepsInIdleRound) {
     if (EnoughGarbageSinceLastIdleRound()) {
       StartIdleRound();
@@ -5844,34 +6074,178 @@ bool Heap::IdleNotification(int hint) {
   mark_sweeps_since_idle_round_started_ += new_mark_sweeps;
   ms_count_at_last_idle_notification_ = ms_count_;
 
-  int remaining_mark_sweeps = kMaxMarkSweepsInIdleRound -
-                              mark_sweeps_since_idle_round_started_;
+  *remaining_mark_sweeps = kMaxMarkSweepsInIdleRound -
+                           mark_sweeps_since_idle_round_started_;
 
-  if (remaining_mark_sweeps <= 0) {
+  if (*remaining_mark_sweeps <= 0) {
     FinishIdleRound();
     return true;
   }
+  return false;
+}
 
-  if (incremental_marking()->IsStopped()) {
-    // If there are no more than two GCs left in this idle round and we are
-    // allowed to do a full GC, then make those GCs full in order to compact
-    // the code space.
-    // TODO(ulan): Once we enable code compaction for incremental marking,
-    // we can get rid of this special case and always start incremental marking.
-    if (remaining_mark_sweeps <= 2 && hint >= kMinHintForFullGC) {
+
+bool Heap::IdleNotificationInMs(int idle_time_in_ms) {
+  if (idle_time_in_ms <= 0) return false;
+
+  double deadline_in_ms = OS::TimeCurrentMillis() + idle_time_in_ms;
+
+  // The same policies as in IdleNotification, but the hint there is a
+  // unitless amount of work, so they are applied to the idle time here.
+  if (contexts_disposed_ > 0) {
+    if (idle_time_in_ms >= kMaxIdleTimeInMs) AgeInlineCaches();
+    if (!FLAG_expose_gc && incremental_marking()->IsStopped() &&
+        EstimateMarkCompactTimeInMs() <= idle_time_in_ms) {
+      HistogramTimerScope scope(isolate_->counters()->gc_context());
       CollectAllGarbage(kReduceMemoryFootprintMask,
-                        "idle notification: finalize idle round");
+                        "idle notification: contexts disposed");
     } else {
-      incremental_marking()->Start();
+      if (!incremental_marking()->IsStopped()) {
+        AdvanceIdleIncrementalMarkingInMs(deadline_in_ms);
+      }
+      contexts_disposed_ = 0;
     }
+    StartIdleRound();
+    return false;
+  }
+
+  // Without incremental marking there is no work to split up, only full
+  // collections that are done if they fit.
+  if (!FLAG_incremental_marking || FLAG_expose_gc || Serializer::enabled()) {
+    if (EstimateMarkCompactTimeInMs() > idle_time_in_ms) return false;
+    return IdleGlobalGC();
+  }
+
+  if (incremental_marking()->IsStopped()) {
+    if (!mark_compact_collector()->AreSweeperThreadsActivated() &&
+        !IsSweepingComplete() &&
+        !AdvanceIdleSweepersInMs(deadline_in_ms)) {
+      return false;
+    }
+  }
+
+  int remaining_mark_sweeps;
+  if (IdleRoundIsOver(&remaining_mark_sweeps)) return true;
+
+  if (incremental_marking()->IsStopped()) {
+    // Finish the round with full compacting GCs if they fit into the idle
+    // time, see IdleNotification.
+    double idle_time_left = deadline_in_ms - OS::TimeCurrentMillis();
+    if (remaining_mark_sweeps <= 2 &&
+        EstimateMarkCompactTimeInMs() <= idle_time_left) {
+      if (remaining_mark_sweeps == 1) {
+        ReduceMemoryFootprint("idle notification: finalize idle round");
+      } else {
+        CollectAllGarbage(kReduceMemoryFootprintMask,
+                          "idle notification: finalize idle round");
+      }
+      return false;
+    }
+    incremental_marking()->Start();
   }
   if (!incremental_marking()->IsStopped()) {
-    AdvanceIdleIncrementalMarking(step_size);
+    AdvanceIdleIncrementalMarkingInMs(deadline_in_ms);
   }
   return false;
 }
 
 
+void Heap::AdvanceIdleIncrementalMarkingInMs(double deadline_in_ms) {
+  IncrementalMarking* marking = incremental_marking();
+  while (true) {
+    intptr_t step_size = IdleStepSize(deadline_in_ms,
+                                      idle_marking_speed_in_bytes_per_ms_,
+                                      kInitialIdleMarkingSpeedInBytesPerMs);
+    if (step_size < kMinIdleStepSize) break;
+    double start = OS::TimeCurrentMillis();
+    bool was_marking = marking->IsMarkingIncomplete();
+    if (!marking->IdleStep(step_size)) break;
+    if (was_marking) {
+      UpdateSpeed(&idle_marking_speed_in_bytes_per_ms_,
+                  step_size,
+                  OS::TimeCurrentMillis() - start);
+    }
+    // Stop when marking is complete, or when sweeping left over from the
+    // previous GC still has to finish (it may be done by sweeper threads).
+    if (!marking->IsMarkingIncomplete()) break;
+  }
+
+  if (marking->IsComplete()) {
+    // Leave the final pause to a later idle period or to the next
+    // allocation if it would overrun the deadline.
+    double idle_time_left = deadline_in_ms - OS::TimeCurrentMillis();
+    if (EstimateFinalIncrementalMarkCompactTimeInMs() <= idle_time_left) {
+      FinalizeIdleIncrementalMarking();
+    }
+  }
+}
+
+
+bool Heap::AdvanceIdleSweepersInMs(double deadline_in_ms) {
+  while (true) {
+    intptr_t step_size = IdleStepSize(deadline_in_ms,
+                                      idle_sweeping_speed_in_bytes_per_ms_,
+                                      kInitialIdleSweepingSpeedInBytesPerMs);
+    if (step_size < kMinIdleStepSize) return false;
+    double start = OS::TimeCurrentMillis();
+    bool sweeping_complete = AdvanceSweepers(static_cast<int>(step_size));
+    UpdateSpeed(&idle_sweeping_speed_in_bytes_per_ms_,
+                step_size,
+                OS::TimeCurrentMillis() - start);
+    if (sweeping_complete) return true;
+  }
+}
+
+
+double Heap::EstimateMarkCompactTimeInMs() {
+  intptr_t speed = mark_compact_speed_in_bytes_per_ms_;
+  if (speed == 0) speed = kInitialMarkCompactSpeedInBytesPerMs;
+  return static_cast<double>(SizeOfObjects()) / speed;
+}
+
+
+double Heap::EstimateFinalIncrementalMarkCompactTimeInMs() {
+  intptr_t speed = final_incremental_mark_compact_speed_in_bytes_per_ms_;
+  if (speed == 0) {
+    // Most of the marking is already done, so until measured assume the
+    // final pause is faster than a whole non-incremental collection.
+    speed = 2 * kInitialMarkCompactSpeedInBytesPerMs;
+  }
+  return static_cast<double>(SizeOfObjects()) / speed;
+}
+
+
+intptr_t Heap::IdleStepSize(double deadline_in_ms,
+                            intptr_t speed_in_bytes_per_ms,
+                            intptr_t initial_speed_in_bytes_per_ms) {
+  // Only plan for this fraction of the remaining time, as the speeds are
+  // averages and a step can take longer than predicted.
+  static const double kIdleTimeSlackFactor = 0.8;
+  double time_left = deadline_in_ms - OS::TimeCurrentMillis();
+  if (time_left <= 0) return 0;
+  if (speed_in_bytes_per_ms == 0) {
+    speed_in_bytes_per_ms = initial_speed_in_bytes_per_ms;
+  }
+  double step_size = time_left * kIdleTimeSlackFactor * speed_in_bytes_per_ms;
+  return static_cast<intptr_t>(Min(step_size, static_cast<double>(kMaxInt)));
+}
+
+
+void Heap::UpdateSpeed(intptr_t* speed_in_bytes_per_ms,
+                       intptr_t bytes,
+                       double time_in_ms) {
+  // Timer resolution may make short steps look instantaneous.
+  static const double kMinMeasurableTimeInMs = 0.1;
+  if (bytes <= 0 || time_in_ms < kMinMeasurableTimeInMs) return;
+  intptr_t speed = static_cast<intptr_t>(bytes / time_in_ms);
+  if (speed == 0) speed = 1;
+  // Average with the previous measurement to smooth out outliers.
+  *speed_in_bytes_per_ms =
+      *speed_in_bytes_per_ms == 0 ? speed
+                                  : (*speed_in_bytes_per_ms + speed) / 2;
+}
+
+
 bool Heap::IdleGlobalGC() {
   static const int kIdlesBeforeScavenge = 4;
   static const int kIdlesBeforeMarkSweep = 7;
@@ -6719,6 +7093,7 @@ bool Heap::CreateHeapObjects() {
   if (!CreateInitialObjects()) return false;
 
   native_contexts_list_ = undefined_value();
+  array_buffers_list_ = undefined_value();
   return true;
 }
 
@@ -7942,6 +8317,38 @@ void Heap::CheckpointObjectStats() {
 }
 
 
+bool Heap::GetObjectTypeName(size_t index,
+                             const char** object_type,
+                             const char** object_sub_type) {
+  if (index >= OBJECT_STATS_COUNT) return false;
+
+  switch (static_cast<int>(index)) {
+#define COMPARE_AND_RETURN_NAME(name) \
+    case name:                        \
+      *object_type = #name;           \
+      *object_sub_type = "";          \
+      return true;
+    INSTANCE_TYPE_LIST(COMPARE_AND_RETURN_NAME)
+#undef COMPARE_AND_RETURN_NAME
+#define COMPARE_AND_RETURN_NAME(name)               \
+    case FIRST_CODE_KIND_SUB_TYPE + Code::name:     \
+      *object_type = "CODE_TYPE";                   \
+      *object_sub_type = "CODE_KIND/" #name;        \
+      return true;
+    CODE_KIND_LIST(COMPARE_AND_RETURN_NAME)
+#undef COMPARE_AND_RETURN_NAME
+#define COMPARE_AND_RETURN_NAME(name)               \
+    case FIRST_FIXED_ARRAY_SUB_TYPE + name:         \
+      *object_type = "FIXED_ARRAY_TYPE";            \
+      *object_sub_type = #name;                     \
+      return true;
+    FIXED_ARRAY_SUB_INSTANCE_TYPE_LIST(COMPARE_AND_RETURN_NAME)
+#undef COMPARE_AND_RETURN_NAME
+  }
+  return false;
+}
+
+
 Heap::RelocationLock::RelocationLock(Heap* heap) : heap_(heap) {
   if (FLAG_parallel_recompilation) {
     heap_->relocation_mutex_->Lock();
@@ -85,6 +85,7 @@ namespace internal {
   V(FixedArray, single_character_string_cache, SingleCharacterStringCache)     \
   V(FixedArray, string_split_cache, StringSplitCache)                          \
   V(FixedArray, regexp_multiple_cache, RegExpMultipleCache)                    \
+  V(FixedArray, string_builder_cache, StringBuilderCache)                      \
   V(Object, termination_exception, TerminationException)                       \
   V(Smi, hash_seed, HashSeed)                                                  \
   V(Map, symbol_map, SymbolMap)                                                \
@@ -1237,6 +1238,9 @@ class Heap {
   static const int kSweepPreciselyMask = 1;
   static const int kReduceMemoryFootprintMask = 2;
   static const int kAbortIncrementalMarkingMask = 4;
+  // Evacuates every sparse page and releases all empty pages instead of
+  // stopping at the limits tuned for throughput.
+  static const int kCompactSparsePagesMask = 8;
 
   // Making the heap iterable requires us to sweep precisely and abort any
   // incremental marking as well.
@@ -1251,6 +1255,11 @@ class Heap {
   // Last hope GC, should try to squeeze as much as possible.
   void CollectAllAvailableGarbage(const char* gc_reason = NULL);
 
+  // Releases as much memory as possible back to the OS for an isolate that
+  // is not expected to run for a while: compacts all sparse pages and
+  // shrinks new space, the store buffer and the marking deque.
+  void ReduceMemoryFootprint(const char* gc_reason = NULL);
+
   // Check whether the heap is currently iterable.
   bool IsHeapIterable();
 
@@ -1343,6 +1352,11 @@ class Heap {
   }
   Object* native_contexts_list() { return native_contexts_list_; }
 
+  void set_array_buffers_list(Object* object) {
+    array_buffers_list_ = object;
+  }
+  Object* array_buffers_list() { return array_buffers_list_; }
+
   // Number of mark-sweeps.
   unsigned int ms_count() { return ms_count_; }
 
@@ -1612,6 +1626,9 @@ class Heap {
   // Implements the corresponding V8 API function.
   bool IdleNotification(int hint);
 
+  // Implements the corresponding V8 API function.
+  bool IdleNotificationInMs(int idle_time_in_ms);
+
   // Declare all the root indices.
   enum RootListIndex {
 #define ROOT_INDEX_DECLARATION(type, name, camel_name) k##camel_name##RootIndex,
@@ -1899,6 +1916,22 @@ class Heap {
 
   void CheckpointObjectStats();
 
+  size_t ObjectCountAtLastGC(size_t index) {
+    ASSERT(index < OBJECT_STATS_COUNT);
+    return object_counts_last_time_[index];
+  }
+
+  size_t ObjectSizeAtLastGC(size_t index) {
+    ASSERT(index < OBJECT_STATS_COUNT);
+    return object_sizes_last_time_[index];
+  }
+
+  // Returns the type and sub type names of an object stats entry, or false
+  // if the entry is unused.
+  static bool GetObjectTypeName(size_t index,
+                                const char** object_type,
+                                const char** object_sub_type);
+
   // We don't use a ScopedLock here since we want to lock the heap
   // only when FLAG_parallel_recompilation is true.
   class RelocationLock {
@@ -2047,6 +2080,9 @@ class Heap {
 
   Object* native_contexts_list_;
 
+  // Weak list of all array buffers, each heading the weak list of its views.
+  Object* array_buffers_list_;
+
   StoreBufferRebuilder store_buffer_rebuilder_;
 
   struct StringTypeTable {
@@ -2319,6 +2355,35 @@ class Heap {
   bool IdleGlobalGC();
 
   void AdvanceIdleIncrementalMarking(intptr_t step_size);
+  void FinalizeIdleIncrementalMarking();
+
+  // Returns true if the current idle round is over, otherwise returns the
+  // number of mark-sweeps it may still perform.
+  bool IdleRoundIsOver(int* remaining_mark_sweeps);
+
+  // Deadline-driven counterparts of the above. Work is split into chunks
+  // sized from the measured speeds below so that it ends before the
+  // deadline, given in OS::TimeCurrentMillis() time.
+  void AdvanceIdleIncrementalMarkingInMs(double deadline_in_ms);
+  bool AdvanceIdleSweepersInMs(double deadline_in_ms);
+
+  // Idle times of at least this long allow as much work as the largest
+  // IdleNotification hint.
+  static const int kMaxIdleTimeInMs = 1000;
+
+  // Estimated time of a non-incremental mark-compact of the whole heap,
+  // and of the one finishing a completed incremental marking.
+  double EstimateMarkCompactTimeInMs();
+  double EstimateFinalIncrementalMarkCompactTimeInMs();
+
+  // Returns how many bytes of work a given speed gets done in the time
+  // left until the deadline, leaving some slack for misprediction.
+  static intptr_t IdleStepSize(double deadline_in_ms,
+                               intptr_t speed_in_bytes_per_ms,
+                               intptr_t initial_speed_in_bytes_per_ms);
+  static void UpdateSpeed(intptr_t* speed_in_bytes_per_ms,
+                          intptr_t bytes,
+                          double time_in_ms);
 
   void ClearObjectStats(bool clear_last_time_stats = false);
 
@@ -2372,6 +2437,13 @@ class Heap {
   unsigned int gc_count_at_last_idle_gc_;
   int scavenges_since_last_idle_round_;
 
+  // Speeds of GC work in bytes per ms, used to fit the work done in
+  // IdleNotificationInMs into the idle time. Zero until first measured.
+  intptr_t idle_marking_speed_in_bytes_per_ms_;
+  intptr_t idle_sweeping_speed_in_bytes_per_ms_;
+  intptr_t mark_compact_speed_in_bytes_per_ms_;
+  intptr_t final_incremental_mark_compact_speed_in_bytes_per_ms_;
+
   // If the --deopt_every_n_garbage_collections flag is set to a positive value,
   // this variable holds the number of garbage collections since the last
   // deoptimization triggered by garbage collection.
@@ -2384,6 +2456,13 @@ class Heap {
   static const int kMaxMarkSweepsInIdleRound = 7;
   static const int kIdleScavengeThreshold = 5;
 
+  // Speeds assumed for idle-time GC work until they have been measured.
+  static const intptr_t kInitialIdleMarkingSpeedInBytesPerMs = 1 * MB;
+  static const intptr_t kInitialIdleSweepingSpeedInBytesPerMs = 1 * MB;
+  static const intptr_t kInitialMarkCompactSpeedInBytesPerMs = 2 * MB;
+  // Idle steps smaller than this are not worth their overhead.
+  static const intptr_t kMinIdleStepSize = 16 * KB;
+
   // Shared state read by the scavenge collector and set by ScavengeObject.
   PromotionQueue promotion_queue_;
 
@@ -2926,6 +3005,32 @@ class RegExpResultsCache {
 };
 
 
+// Remembers the over-allocated backing stores that String::SlowTryFlatten
+// creates for strings built by repeated concatenation, together with the
+// number of characters in use. Characters past that point are not seen by
+// any string yet, so they can be appended in place. Flushed on mark-compact.
+class StringBuilderCache {
+ public:
+  // Returns the number of characters in use, or -1 if |store| is unknown.
+  static int Lookup(Heap* heap, String* store);
+  // Records |store| as the most recently used backing store.
+  static void Enter(Heap* heap, String* store, int used_length);
+  static void Clear(FixedArray* cache);
+
+  // Strings shorter than this are flattened into exactly sized strings.
+  static const int kMinLength = 256;
+
+  static const int kStringBuilderCacheEntries = 4;
+  static const int kArrayEntriesPerCacheEntry = 2;
+  static const int kStringBuilderCacheSize =
+      kStringBuilderCacheEntries * kArrayEntriesPerCacheEntry;
+
+ private:
+  static const int kStoreOffset = 0;
+  static const int kUsedLengthOffset = 1;
+};
+
+
 class TranscendentalCache {
  public:
   enum Type {ACOS, ASIN, ATAN, COS, EXP, LOG, SIN, TAN, kNumberOfCaches};
@@ -2050,6 +2050,34 @@ void HSimulate::PrintDataTo(StringStream* stream) {
 }
 
 
+void HCapturedObject::ReplayEnvironment(HEnvironment* env) {
+  ASSERT(env != NULL);
+  while (env != NULL) {
+    for (int i = 0; i < env->length(); ++i) {
+      HValue* value = env->values()->at(i);
+      if (value->IsCapturedObject() &&
+          HCapturedObject::cast(value)->capture_id() == capture_id()) {
+        env->SetValueAt(i, this);
+      }
+    }
+    env = env->outer();
+  }
+}
+
+
+void HCapturedObject::PrintDataTo(StringStream* stream) {
+  stream->Add("#%d", capture_id());
+  for (int i = 0; i < values_.length(); ++i) {
+    stream->Add(" ");
+    if (values_[i] == NULL) {
+      stream->Add("-");
+    } else {
+      values_[i]->PrintNameTo(stream);
+    }
+  }
+}
+
+
 void HDeoptimize::PrintDataTo(StringStream* stream) {
   if (OperandCount() == 0) return;
   OperandAt(0)->PrintNameTo(stream);
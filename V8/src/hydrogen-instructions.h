@@ -86,6 +86,7 @@ class LChunkBuilder;
   V(CallNewArray)                              \
   V(CallRuntime)                               \
   V(CallStub)                                  \
+  V(CapturedObject)                            \
   V(Change)                                    \
   V(CheckFunction)                             \
   V(CheckInstanceType)                         \
@@ -1867,6 +1868,50 @@ class HSimulate: public HInstruction {
 };
 
 
+class HCapturedObject: public HInstruction {
+ public:
+  HCapturedObject(int length, int capture_id, Zone* zone)
+      : values_(length, zone),
+        capture_id_(capture_id) {
+    values_.AddBlock(NULL, length, zone);  // Resize list.
+    set_representation(Representation::Tagged());
+  }
+
+  // The values contain a list of all in-object fields of the captured object,
+  // indexed by field index starting at the map word. Properties and elements
+  // backing stores are not tracked here.
+  const ZoneList<HValue*>* values() const { return &values_; }
+  int length() const { return values_.length(); }
+
+  // All states of the same allocation share the capture id.
+  int capture_id() const { return capture_id_; }
+
+  // Replay effects of this instruction on the given environment, i.e. replace
+  // all earlier states of the same captured object with this one.
+  void ReplayEnvironment(HEnvironment* env);
+
+  virtual int OperandCount() { return values_.length(); }
+  virtual HValue* OperandAt(int index) const { return values_[index]; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(CapturedObject)
+
+ protected:
+  virtual void InternalSetOperandAt(int index, HValue* value) {
+    values_[index] = value;
+  }
+
+ private:
+  ZoneList<HValue*> values_;
+  int capture_id_;
+};
+
+
 class HStackCheck: public HTemplateInstruction<1> {
  public:
   enum Type {
@@ -2989,10 +3034,14 @@ class HPhi: public HValue {
       non_phi_uses_[i] = 0;
       indirect_uses_[i] = 0;
     }
-    ASSERT(merged_index >= 0);
+    ASSERT(merged_index >= 0 || merged_index == kInvalidMergedIndex);
     SetFlag(kFlexibleRepresentation);
   }
 
+  // Phis created by optimization passes do not correspond to an environment
+  // slot and carry this merged index.
+  static const int kInvalidMergedIndex = -1;
+
   virtual Representation RepresentationFromInputs();
 
   virtual Range* InferRange(Zone* zone);
@@ -3011,6 +3060,7 @@ class HPhi: public HValue {
   bool IsReceiver() const { return merged_index_ == 0; }
 
   int merged_index() const { return merged_index_; }
+  bool HasMergedIndex() const { return merged_index_ != kInvalidMergedIndex; }
 
   virtual void AddInformativeDefinitions();
 
@@ -3130,6 +3130,896 @@ void HStackCheckEliminator::Process() {
 }
 
 
+// Replaces allocations that never escape the optimized function with their
+// in-object fields as SSA values. Only plain JSObjects whose fields are all
+// stored in-object are considered; the deoptimizer rematerializes captured
+// objects from the HCapturedObject states recorded in the environments.
+class HEscapeAnalysis BASE_EMBEDDED {
+ public:
+  explicit HEscapeAnalysis(HGraph* graph)
+      : graph_(graph),
+        zone_(graph->zone()),
+        captured_(0, graph->zone()),
+        entries_(0, graph->zone()),
+        block_states_(0, graph->zone()),
+        block_captures_(0, graph->zone()),
+        next_capture_id_(0) { }
+
+  void Analyze();
+
+ private:
+  typedef ZoneList<HValue*> State;
+
+  void CollectCapturedValues();
+  int CapturedObjectSize(HInstruction* instr);
+  static bool IsHeaderOf(HValue* value, HInstruction* allocate);
+  bool HasNoEscapingUses(HInstruction* allocate, HValue* object, int size);
+  bool HasOnlyTypecheckUses(HValue* check, HValue* object);
+  bool IsInLoopEnteredAfter(HBasicBlock* block, HBasicBlock* allocate_block);
+  bool IsFieldAccess(bool is_in_object, int offset, int size);
+  bool AnalyzeDataFlow(HInstruction* allocate, int size, bool replace);
+
+  State* NewInitialState(HInstruction* allocate, int length, bool replace);
+  State* NewStateCopy(State* state);
+  State* MergeStates(HBasicBlock* block, HInstruction* allocate, bool replace,
+                     HCapturedObject** capture);
+  HCapturedObject* NewCapture(State* state, int capture_id);
+  HConstant* NewMapConstant(Handle<Map> map, HInstruction* position,
+                            bool replace);
+  bool IsComplete(State* state);
+
+  HGraph* graph_;
+  Zone* zone_;
+  ZoneList<HInstruction*> captured_;
+  ZoneList<HEnterInlined*> entries_;
+  ZoneList<State*> block_states_;
+  ZoneList<HCapturedObject*> block_captures_;
+  int next_capture_id_;
+};
+
+
+void HEscapeAnalysis::Analyze() {
+  HPhase phase("H_Escape analysis", graph_);
+  CollectCapturedValues();
+  for (int i = 0; i < captured_.length(); ++i) {
+    HInstruction* allocate = captured_.at(i);
+    int size = CapturedObjectSize(allocate);
+    // Do a dry run first so that the graph stays untouched if the data flow
+    // of the object cannot be resolved statically.
+    if (!AnalyzeDataFlow(allocate, size, false)) {
+      if (FLAG_trace_escape_analysis) {
+        PrintF("Escape analysis: data flow of #%d not resolvable\n",
+               allocate->id());
+      }
+      continue;
+    }
+    if (FLAG_trace_escape_analysis) {
+      PrintF("Escape analysis: replacing #%d %s (%d bytes)\n",
+             allocate->id(), allocate->Mnemonic(), size);
+    }
+    AnalyzeDataFlow(allocate, size, true);
+  }
+}
+
+
+void HEscapeAnalysis::CollectCapturedValues() {
+  const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
+  for (int i = 0; i < blocks->length(); ++i) {
+    for (HInstruction* instr = blocks->at(i)->first();
+         instr != NULL;
+         instr = instr->next()) {
+      if (instr->IsEnterInlined()) entries_.Add(HEnterInlined::cast(instr),
+                                                zone_);
+    }
+  }
+  for (int i = 0; i < blocks->length(); ++i) {
+    for (HInstruction* instr = blocks->at(i)->first();
+         instr != NULL;
+         instr = instr->next()) {
+      int size = CapturedObjectSize(instr);
+      if (size == 0) continue;
+      if (instr->IsAllocate()) {
+        // Literals address their header through inner allocated objects at
+        // offset zero, which are nothing but the allocation itself.
+        bool has_inner_objects = false;
+        for (HUseIterator it(instr->uses()); !it.Done(); it.Advance()) {
+          HValue* use = it.value();
+          if (use->IsInnerAllocatedObject() &&
+              HInnerAllocatedObject::cast(use)->offset() != 0) {
+            has_inner_objects = true;
+          }
+        }
+        if (has_inner_objects) continue;
+      }
+      if (HasNoEscapingUses(instr, instr, size)) {
+        if (FLAG_trace_escape_analysis) {
+          PrintF("Escape analysis: #%d %s is a candidate\n",
+                 instr->id(), instr->Mnemonic());
+        }
+        // Only now that the object is known not to escape, let the uses of
+        // its header refer to the allocation directly.
+        HUseIterator it(instr->uses());
+        while (!it.Done()) {
+          HValue* use = it.value();
+          it.Advance();
+          if (IsHeaderOf(use, instr)) use->DeleteAndReplaceWith(instr);
+        }
+        captured_.Add(instr, zone_);
+      } else if (FLAG_trace_escape_analysis) {
+        PrintF("Escape analysis: #%d %s escapes\n",
+               instr->id(), instr->Mnemonic());
+      }
+    }
+  }
+}
+
+
+// Returns the instance size of allocations that are candidates for being
+// captured, or zero if the allocation cannot be captured at all.
+int HEscapeAnalysis::CapturedObjectSize(HInstruction* instr) {
+  if (instr->IsAllocateObject()) {
+    Handle<Map> map = HAllocateObject::cast(instr)->constructor_initial_map();
+    if (map.is_null() || map->instance_type() != JS_OBJECT_TYPE) return 0;
+    return map->instance_size();
+  }
+  if (instr->IsAllocate()) {
+    HAllocate* allocate = HAllocate::cast(instr);
+    if (!allocate->CalculateInferredType().IsJSObject()) return 0;
+    if (allocate->MustAllocateDoubleAligned()) return 0;
+    if (!allocate->size()->IsConstant()) return 0;
+    HConstant* size = HConstant::cast(allocate->size());
+    if (!size->HasInteger32Value()) return 0;
+    int value = size->Integer32Value();
+    if (value < JSObject::kHeaderSize ||
+        value > HAllocateObject::kMaxSize ||
+        value % kPointerSize != 0) {
+      return 0;
+    }
+    return value;
+  }
+  return 0;
+}
+
+
+bool HEscapeAnalysis::IsFieldAccess(bool is_in_object, int offset, int size) {
+  return is_in_object &&
+      offset >= 0 &&
+      offset < size &&
+      offset % kPointerSize == 0;
+}
+
+
+bool HEscapeAnalysis::IsInLoopEnteredAfter(HBasicBlock* block,
+                                           HBasicBlock* allocate_block) {
+  HBasicBlock* header =
+      block->IsLoopHeader() ? block : block->parent_loop_header();
+  while (header != NULL) {
+    if (header != allocate_block && allocate_block->Dominates(header)) {
+      return true;
+    }
+    header = header->parent_loop_header();
+  }
+  return false;
+}
+
+
+bool HEscapeAnalysis::IsHeaderOf(HValue* value, HInstruction* allocate) {
+  return value->IsInnerAllocatedObject() &&
+      HInnerAllocatedObject::cast(value)->base_object() == allocate &&
+      HInnerAllocatedObject::cast(value)->offset() == 0;
+}
+
+
+bool HEscapeAnalysis::HasOnlyTypecheckUses(HValue* check, HValue* object) {
+  for (HUseIterator it(check->uses()); !it.Done(); it.Advance()) {
+    HValue* use = it.value();
+    if (!use->IsLoadNamedField() || it.index() != 1) return false;
+    if (HLoadNamedField::cast(use)->object() != object) return false;
+  }
+  return true;
+}
+
+
+// Checks the uses of |object|, which is either |allocate| itself or the
+// header of a literal allocation. Headers are looked through without
+// touching the graph.
+bool HEscapeAnalysis::HasNoEscapingUses(HInstruction* allocate,
+                                        HValue* object,
+                                        int size) {
+  HBasicBlock* allocate_block = allocate->block();
+  bool is_literal = allocate->IsAllocate();
+  for (HUseIterator it(object->uses()); !it.Done(); it.Advance()) {
+    HValue* use = it.value();
+    if (use->IsSimulate()) continue;
+    if (object == allocate && IsHeaderOf(use, allocate)) {
+      if (!HasNoEscapingUses(allocate, use, size)) return false;
+      continue;
+    }
+    if (use->IsStoreNamedField()) {
+      HStoreNamedField* store = HStoreNamedField::cast(use);
+      if (it.index() != 0) return false;
+      if (!IsFieldAccess(store->is_in_object(), store->offset(), size)) {
+        return false;
+      }
+      if (store->field_representation().IsDouble()) return false;
+      HValue* value = store->value();
+      if (value == allocate || IsHeaderOf(value, allocate) ||
+          value->IsArgumentsObject()) {
+        return false;
+      }
+      if (IsInLoopEnteredAfter(store->block(), allocate_block)) return false;
+      if (!store->transition().is_null()) {
+        Handle<Map> transition = store->transition();
+        if (transition->instance_type() != JS_OBJECT_TYPE ||
+            transition->instance_size() != size) {
+          return false;
+        }
+      }
+      if (store->offset() < JSObject::kHeaderSize) {
+        // Only literals initialize their header explicitly.
+        if (!is_literal) return false;
+        if (store->offset() == JSObject::kMapOffset) {
+          if (!value->IsConstant()) return false;
+          Handle<Object> map = HConstant::cast(value)->handle();
+          if (!map->IsMap() ||
+              Handle<Map>::cast(map)->instance_type() != JS_OBJECT_TYPE ||
+              Handle<Map>::cast(map)->instance_size() != size) {
+            return false;
+          }
+        }
+      }
+      continue;
+    }
+    if (use->IsLoadNamedField()) {
+      HLoadNamedField* load = HLoadNamedField::cast(use);
+      if (load->object() != object) return false;
+      if (!IsFieldAccess(load->is_in_object(), load->offset(), size)) {
+        return false;
+      }
+      if (load->representation().IsDouble()) return false;
+      continue;
+    }
+    if (use->IsCheckMaps()) {
+      if (HCheckMaps::cast(use)->value() != object) return false;
+      if (!HasOnlyTypecheckUses(use, object)) return false;
+      continue;
+    }
+    if (use->IsCheckNonSmi()) {
+      if (!HasOnlyTypecheckUses(use, object)) return false;
+      continue;
+    }
+    return false;
+  }
+
+  // The arguments object of inlined functions references its values outside
+  // of the operand lists.
+  for (int i = 0; i < entries_.length(); ++i) {
+    ZoneList<HValue*>* arguments_values = entries_.at(i)->arguments_values();
+    if (arguments_values == NULL) continue;
+    if (arguments_values->Contains(object)) return false;
+  }
+  return true;
+}
+
+
+HEscapeAnalysis::State* HEscapeAnalysis::NewInitialState(
+    HInstruction* allocate, int length, bool replace) {
+  State* state = new(zone_) State(length, zone_);
+  state->AddBlock(NULL, length, zone_);
+  if (allocate->IsAllocateObject()) {
+    // Inlined constructors start out with the initial map and empty backing
+    // stores, all in-object properties are pre-filled with undefined.
+    HAllocateObject* allocate_object = HAllocateObject::cast(allocate);
+    Handle<FixedArray> empty_fixed_array =
+        graph_->isolate()->factory()->empty_fixed_array();
+    HConstant* empty = new(zone_) HConstant(empty_fixed_array,
+                                            Representation::Tagged());
+    if (replace) empty->InsertBefore(allocate);
+    state->at(0) = NewMapConstant(allocate_object->constructor_initial_map(),
+                                  allocate, replace);
+    state->at(JSObject::kPropertiesOffset / kPointerSize) = empty;
+    state->at(JSObject::kElementsOffset / kPointerSize) = empty;
+    for (int i = JSObject::kHeaderSize / kPointerSize; i < length; ++i) {
+      state->at(i) = graph_->GetConstantUndefined();
+    }
+  }
+  return state;
+}
+
+
+HEscapeAnalysis::State* HEscapeAnalysis::NewStateCopy(State* state) {
+  State* copy = new(zone_) State(state->length(), zone_);
+  copy->AddAll(*state, zone_);
+  return copy;
+}
+
+
+HConstant* HEscapeAnalysis::NewMapConstant(Handle<Map> map,
+                                           HInstruction* position,
+                                           bool replace) {
+  HConstant* constant = new(zone_) HConstant(map, Representation::Tagged());
+  if (replace) constant->InsertBefore(position);
+  return constant;
+}
+
+
+bool HEscapeAnalysis::IsComplete(State* state) {
+  for (int i = 0; i < state->length(); ++i) {
+    if (state->at(i) == NULL) return false;
+  }
+  return true;
+}
+
+
+HCapturedObject* HEscapeAnalysis::NewCapture(State* state, int capture_id) {
+  HCapturedObject* capture =
+      new(zone_) HCapturedObject(state->length(), capture_id, zone_);
+  for (int i = 0; i < state->length(); ++i) {
+    capture->SetOperandAt(i, state->at(i));
+  }
+  return capture;
+}
+
+
+// Merges the states of all predecessors of a join block. Differing fields
+// are merged with new phis which are only attached to the graph when the
+// graph is actually rewritten.
+HEscapeAnalysis::State* HEscapeAnalysis::MergeStates(
+    HBasicBlock* block,
+    HInstruction* allocate,
+    bool replace,
+    HCapturedObject** capture) {
+  const ZoneList<HBasicBlock*>* predecessors = block->predecessors();
+  State* first = block_states_.at(predecessors->at(0)->block_id());
+  bool all_same = true;
+  for (int i = 0; i < predecessors->length(); ++i) {
+    State* state = block_states_.at(predecessors->at(i)->block_id());
+    if (state == NULL || !IsComplete(state)) return NULL;
+    if (state != first) all_same = false;
+  }
+  if (all_same) {
+    *capture = block_captures_.at(predecessors->at(0)->block_id());
+    return first;
+  }
+
+  State* merged = NewStateCopy(first);
+  for (int field = 0; field < merged->length(); ++field) {
+    bool needs_phi = false;
+    for (int i = 1; i < predecessors->length(); ++i) {
+      State* state = block_states_.at(predecessors->at(i)->block_id());
+      if (state->at(field) != first->at(field)) needs_phi = true;
+    }
+    if (!needs_phi) continue;
+    HPhi* phi = new(zone_) HPhi(HPhi::kInvalidMergedIndex, zone_);
+    if (replace) {
+      block->AddPhi(phi);
+      for (int i = 0; i < predecessors->length(); ++i) {
+        State* state = block_states_.at(predecessors->at(i)->block_id());
+        phi->AddInput(state->at(field));
+      }
+    }
+    merged->at(field) = phi;
+  }
+  *capture = NULL;
+  if (replace) {
+    *capture = NewCapture(merged, next_capture_id_);
+    (*capture)->InsertAfter(block->first());
+  }
+  return merged;
+}
+
+
+// Walks all blocks dominated by the allocation in reverse post order while
+// tracking the field values of the object. In replace mode, loads are
+// replaced with the tracked values, stores and checks are removed and all
+// environment uses are redirected to the HCapturedObject describing the
+// object at that point. Returns false if the object cannot be captured.
+bool HEscapeAnalysis::AnalyzeDataFlow(HInstruction* allocate,
+                                      int size,
+                                      bool replace) {
+  const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
+  HBasicBlock* allocate_block = allocate->block();
+  int length = size / kPointerSize;
+  block_states_.Rewind(0);
+  block_states_.AddBlock(NULL, blocks->length(), zone_);
+  block_captures_.Rewind(0);
+  block_captures_.AddBlock(NULL, blocks->length(), zone_);
+
+  for (int i = allocate_block->block_id(); i < blocks->length(); ++i) {
+    HBasicBlock* block = blocks->at(i);
+    if (block != allocate_block && !allocate_block->Dominates(block)) continue;
+
+    State* state = NULL;
+    HCapturedObject* capture = NULL;
+    HInstruction* instr = NULL;
+    if (block == allocate_block) {
+      state = NewInitialState(allocate, length, replace);
+      if (replace && IsComplete(state)) {
+        capture = NewCapture(state, next_capture_id_);
+        capture->InsertBefore(allocate);
+      }
+      instr = allocate->next();
+    } else if (block->predecessors()->length() == 1 || block->IsLoopHeader()) {
+      // Stores inside of loops entered after the allocation are rejected,
+      // hence the state along the back edges equals the one on entry.
+      int pred_id = block->predecessors()->at(0)->block_id();
+      state = block_states_.at(pred_id);
+      capture = block_captures_.at(pred_id);
+      instr = block->first();
+    } else {
+      state = MergeStates(block, allocate, replace, &capture);
+      instr = block->first();
+    }
+    if (state == NULL) return false;
+
+    while (instr != NULL) {
+      HInstruction* next = instr->next();
+      if (instr->IsStoreNamedField() &&
+          HStoreNamedField::cast(instr)->object() == allocate) {
+        HStoreNamedField* store = HStoreNamedField::cast(instr);
+        HValue* value = store->value();
+        state = NewStateCopy(state);
+        state->at(store->offset() / kPointerSize) = value;
+        if (!store->transition().is_null()) {
+          state->at(0) = NewMapConstant(store->transition(), store, replace);
+        }
+        if (replace) {
+          // Keep the representation checks the store would have performed.
+          Representation representation = store->field_representation();
+          HInstruction* check = NULL;
+          if (FLAG_track_fields && representation.IsSmi() &&
+              !value->type().IsSmi()) {
+            check = new(zone_) HCheckSmi(value);
+          } else if (FLAG_track_heap_object_fields &&
+                     representation.IsHeapObject() &&
+                     !value->type().IsHeapObject()) {
+            check = new(zone_) HCheckNonSmi(value);
+          }
+          if (check != NULL) check->InsertBefore(store);
+          capture = NULL;
+          if (IsComplete(state)) {
+            capture = NewCapture(state, next_capture_id_);
+            capture->InsertAfter(store);
+          }
+          store->DeleteAndReplaceWith(NULL);
+        }
+      } else if (instr->IsLoadNamedField() &&
+                 HLoadNamedField::cast(instr)->object() == allocate) {
+        HValue* value = state->at(
+            HLoadNamedField::cast(instr)->offset() / kPointerSize);
+        if (value == NULL) return false;
+        if (replace) instr->DeleteAndReplaceWith(value);
+      } else if (instr->IsCheckMaps() &&
+                 HCheckMaps::cast(instr)->value() == allocate) {
+        HValue* map = state->at(0);
+        if (map == NULL || !map->IsConstant()) return false;
+        Handle<Object> handle = HConstant::cast(map)->handle();
+        SmallMapList* map_set = HCheckMaps::cast(instr)->map_set();
+        bool found = false;
+        for (int j = 0; j < map_set->length(); ++j) {
+          if (*map_set->at(j) == *handle) found = true;
+        }
+        if (!found) return false;
+        if (replace) instr->DeleteAndReplaceWith(allocate);
+      } else if (instr->IsCheckNonSmi() &&
+                 HCheckNonSmi::cast(instr)->value() == allocate) {
+        if (replace) instr->DeleteAndReplaceWith(allocate);
+      } else if (instr->IsSimulate()) {
+        for (int j = 0; j < instr->OperandCount(); ++j) {
+          if (instr->OperandAt(j) != allocate) continue;
+          if (!IsComplete(state)) return false;
+          if (replace) instr->SetOperandAt(j, capture);
+        }
+      }
+      instr = next;
+    }
+    block_states_[i] = state;
+    block_captures_[i] = capture;
+  }
+
+  if (replace) {
+    ASSERT(allocate->HasNoUses());
+    allocate->DeleteAndReplaceWith(NULL);
+    next_capture_id_++;
+  }
+  return true;
+}
+
+
+// Forwards stored and previously loaded field values to later loads of the
+// same field, and removes map checks that are implied by dominating checks,
+// allocations or map transitions. In contrast to GVN the known values are
+// tracked per object, so stores to other fields or to objects that cannot
+// alias do not kill them.
+class HLoadStoreElimination BASE_EMBEDDED {
+ public:
+  explicit HLoadStoreElimination(HGraph* graph)
+      : graph_(graph),
+        zone_(graph->zone()),
+        block_states_(graph->blocks()->length(), graph->zone()) {
+    block_states_.AddBlock(NULL, graph->blocks()->length(), zone_);
+  }
+
+  void Analyze();
+
+ private:
+  struct FieldEntry {
+    HValue* object;
+    bool is_in_object;
+    int offset;
+    HValue* value;
+  };
+
+  struct MapsEntry {
+    HValue* object;
+    SmallMapList* maps;
+    // The map check that established the maps, or NULL if they are known
+    // from an allocation or a map transition.
+    HCheckMaps* check;
+  };
+
+  class State: public ZoneObject {
+   public:
+    explicit State(Zone* zone) : fields(4, zone), maps(4, zone) { }
+
+    ZoneList<FieldEntry> fields;
+    ZoneList<MapsEntry> maps;
+  };
+
+  State* ComputeEntryState(HBasicBlock* block);
+  State* CopyState(State* state);
+  void IntersectStates(State* state, State* other);
+  void ProcessInstruction(HInstruction* instr, State* state);
+  void ProcessLoad(HLoadNamedField* load, State* state);
+  void ProcessStore(HStoreNamedField* store, State* state);
+  void ProcessCheckMaps(HCheckMaps* check, State* state);
+  void ApplyKills(HInstruction* instr, State* state);
+
+  int FindField(State* state, HValue* object, bool is_in_object, int offset);
+  int FindMaps(State* state, HValue* object);
+  void KillFields(State* state, HValue* object, bool is_in_object, int offset);
+  void KillAllFields(State* state);
+  void KillMaps(State* state, HValue* object);
+  void AddField(State* state, HValue* object, bool is_in_object, int offset,
+                HValue* value);
+  void AddMaps(State* state, HValue* object, SmallMapList* maps,
+               HCheckMaps* check);
+
+  static bool MayAlias(HValue* a, HValue* b);
+  static bool ContainsMap(SmallMapList* maps, Handle<Map> map);
+  static bool IsSubset(SmallMapList* maps, SmallMapList* other);
+
+  HGraph* graph_;
+  Zone* zone_;
+  ZoneList<State*> block_states_;
+};
+
+
+void HLoadStoreElimination::Analyze() {
+  HPhase phase("H_Load store elimination", graph_);
+  const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
+  for (int i = 0; i < blocks->length(); ++i) {
+    HBasicBlock* block = blocks->at(i);
+    State* state = ComputeEntryState(block);
+    HInstruction* instr = block->first();
+    while (instr != NULL) {
+      HInstruction* next = instr->next();
+      ProcessInstruction(instr, state);
+      instr = next;
+    }
+    block_states_[block->block_id()] = state;
+  }
+}
+
+
+HLoadStoreElimination::State* HLoadStoreElimination::ComputeEntryState(
+    HBasicBlock* block) {
+  const ZoneList<HBasicBlock*>* predecessors = block->predecessors();
+  State* state = NULL;
+  for (int i = 0; i < predecessors->length(); ++i) {
+    HBasicBlock* predecessor = predecessors->at(i);
+    // Back edges are accounted for by the loop kills below.
+    if (predecessor->block_id() >= block->block_id()) continue;
+    State* predecessor_state = block_states_[predecessor->block_id()];
+    ASSERT(predecessor_state != NULL);
+    if (state == NULL) {
+      state = CopyState(predecessor_state);
+    } else {
+      IntersectStates(state, predecessor_state);
+    }
+  }
+  if (state == NULL) return new(zone_) State(zone_);
+
+  if (block->IsLoopHeader()) {
+    // Only keep what survives every instruction in the loop body.
+    const ZoneList<HBasicBlock*>* loop_blocks =
+        block->loop_information()->blocks();
+    for (int i = 0; i < loop_blocks->length(); ++i) {
+      for (HInstruction* instr = loop_blocks->at(i)->first();
+           instr != NULL;
+           instr = instr->next()) {
+        ApplyKills(instr, state);
+      }
+    }
+  }
+  return state;
+}
+
+
+HLoadStoreElimination::State* HLoadStoreElimination::CopyState(State* state) {
+  State* copy = new(zone_) State(zone_);
+  copy->fields.AddAll(state->fields, zone_);
+  copy->maps.AddAll(state->maps, zone_);
+  return copy;
+}
+
+
+void HLoadStoreElimination::IntersectStates(State* state, State* other) {
+  for (int i = state->fields.length() - 1; i >= 0; --i) {
+    FieldEntry entry = state->fields[i];
+    int j = FindField(other, entry.object, entry.is_in_object, entry.offset);
+    if (j < 0 || other->fields[j].value != entry.value) {
+      state->fields.Remove(i);
+    }
+  }
+  for (int i = state->maps.length() - 1; i >= 0; --i) {
+    MapsEntry entry = state->maps[i];
+    int j = FindMaps(other, entry.object);
+    if (j < 0) {
+      state->maps.Remove(i);
+      continue;
+    }
+    MapsEntry other_entry = other->maps[j];
+    if (!IsSubset(other_entry.maps, entry.maps)) {
+      SmallMapList* maps = new(zone_) SmallMapList(
+          entry.maps->length() + other_entry.maps->length(), zone_);
+      for (int k = 0; k < entry.maps->length(); ++k) {
+        maps->Add(entry.maps->at(k), zone_);
+      }
+      for (int k = 0; k < other_entry.maps->length(); ++k) {
+        Handle<Map> map = other_entry.maps->at(k);
+        if (!ContainsMap(maps, map)) maps->Add(map, zone_);
+      }
+      state->maps[i].maps = maps;
+    }
+    if (other_entry.check != entry.check) state->maps[i].check = NULL;
+  }
+}
+
+
+void HLoadStoreElimination::ProcessInstruction(HInstruction* instr,
+                                               State* state) {
+  if (instr->IsLoadNamedField()) {
+    ProcessLoad(HLoadNamedField::cast(instr), state);
+  } else if (instr->IsStoreNamedField()) {
+    ProcessStore(HStoreNamedField::cast(instr), state);
+  } else if (instr->IsCheckMaps()) {
+    ProcessCheckMaps(HCheckMaps::cast(instr), state);
+  } else if (instr->IsAllocateObject()) {
+    HAllocateObject* allocate = HAllocateObject::cast(instr);
+    Handle<Map> initial_map = allocate->constructor_initial_map();
+    if (!initial_map.is_null()) {
+      SmallMapList* maps = new(zone_) SmallMapList(1, zone_);
+      maps->Add(initial_map, zone_);
+      AddMaps(state, allocate, maps, NULL);
+    }
+  } else {
+    ApplyKills(instr, state);
+  }
+}
+
+
+void HLoadStoreElimination::ProcessLoad(HLoadNamedField* load, State* state) {
+  HValue* object = load->object();
+  int index = FindField(state, object, load->is_in_object(), load->offset());
+  if (index >= 0) {
+    HValue* value = state->fields[index].value;
+    // Stores of smi fields see an untagged value, only forward values that
+    // can directly stand in for the load.
+    if (value->representation().Equals(load->representation()) &&
+        value->type().IsSubtypeOf(load->type())) {
+      if (FLAG_trace_load_elimination) {
+        PrintF("Load elimination: replacing #%d with #%d\n",
+               load->id(), value->id());
+      }
+      load->DeleteAndReplaceWith(value);
+      return;
+    }
+    state->fields.Remove(index);
+  }
+  AddField(state, object, load->is_in_object(), load->offset(), load);
+}
+
+
+void HLoadStoreElimination::ProcessStore(HStoreNamedField* store,
+                                         State* state) {
+  HValue* object = store->object();
+  if (store->CheckGVNFlag(kChangesMaps)) KillMaps(state, object);
+  bool is_double = FLAG_track_double_fields &&
+      store->field_representation().IsDouble();
+  if (!store->transition().is_null() || is_double) {
+    // Map transitions may reallocate the properties backing store and double
+    // fields are stored into a box that other fields may share.
+    KillAllFields(state);
+  } else {
+    KillFields(state, object, store->is_in_object(), store->offset());
+  }
+  if (!store->transition().is_null()) {
+    SmallMapList* maps = new(zone_) SmallMapList(1, zone_);
+    maps->Add(store->transition(), zone_);
+    AddMaps(state, object, maps, NULL);
+  }
+  if (!is_double) {
+    AddField(state, object, store->is_in_object(), store->offset(),
+             store->value());
+  }
+}
+
+
+void HLoadStoreElimination::ProcessCheckMaps(HCheckMaps* check,
+                                             State* state) {
+  HValue* object = check->value();
+  int index = FindMaps(state, object);
+  if (index < 0) {
+    AddMaps(state, object, check->map_set(), check);
+    return;
+  }
+  MapsEntry entry = state->maps[index];
+  if (IsSubset(entry.maps, check->map_set())) {
+    // Uses of the check only order loads after it, the dominating check or
+    // the object itself serves the same purpose.
+    HValue* replacement = entry.check != NULL ? entry.check : object;
+    if (FLAG_trace_load_elimination) {
+      PrintF("Load elimination: removing map check #%d\n", check->id());
+    }
+    check->DeleteAndReplaceWith(replacement);
+    return;
+  }
+  SmallMapList* maps = new(zone_) SmallMapList(entry.maps->length(), zone_);
+  for (int i = 0; i < entry.maps->length(); ++i) {
+    Handle<Map> map = entry.maps->at(i);
+    if (ContainsMap(check->map_set(), map)) maps->Add(map, zone_);
+  }
+  // A check that always fails leaves its own map set behind.
+  if (maps->is_empty()) maps = check->map_set();
+  state->maps[index].maps = maps;
+  state->maps[index].check = check;
+}
+
+
+void HLoadStoreElimination::ApplyKills(HInstruction* instr, State* state) {
+  if (instr->IsStoreNamedField()) {
+    HStoreNamedField* store = HStoreNamedField::cast(instr);
+    if (store->CheckGVNFlag(kChangesMaps)) KillMaps(state, store->object());
+    if (!store->transition().is_null() ||
+        (FLAG_track_double_fields &&
+         store->field_representation().IsDouble())) {
+      KillAllFields(state);
+    } else {
+      KillFields(state, store->object(), store->is_in_object(),
+                 store->offset());
+    }
+    return;
+  }
+  if (instr->CheckGVNFlag(kChangesMaps) ||
+      instr->CheckGVNFlag(kChangesElementsKind)) {
+    KillMaps(state, NULL);
+  }
+  if (instr->CheckGVNFlag(kChangesInobjectFields) ||
+      instr->CheckGVNFlag(kChangesBackingStoreFields) ||
+      instr->CheckGVNFlag(kChangesDoubleFields) ||
+      instr->CheckGVNFlag(kChangesArrayLengths) ||
+      instr->CheckGVNFlag(kChangesElementsPointer)) {
+    KillAllFields(state);
+  }
+}
+
+
+int HLoadStoreElimination::FindField(State* state,
+                                     HValue* object,
+                                     bool is_in_object,
+                                     int offset) {
+  for (int i = 0; i < state->fields.length(); ++i) {
+    FieldEntry entry = state->fields[i];
+    if (entry.object == object &&
+        entry.is_in_object == is_in_object &&
+        entry.offset == offset) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+int HLoadStoreElimination::FindMaps(State* state, HValue* object) {
+  for (int i = 0; i < state->maps.length(); ++i) {
+    if (state->maps[i].object == object) return i;
+  }
+  return -1;
+}
+
+
+void HLoadStoreElimination::KillFields(State* state,
+                                       HValue* object,
+                                       bool is_in_object,
+                                       int offset) {
+  for (int i = state->fields.length() - 1; i >= 0; --i) {
+    FieldEntry entry = state->fields[i];
+    if (entry.is_in_object == is_in_object &&
+        entry.offset == offset &&
+        MayAlias(entry.object, object)) {
+      state->fields.Remove(i);
+    }
+  }
+}
+
+
+void HLoadStoreElimination::KillAllFields(State* state) {
+  state->fields.Rewind(0);
+}
+
+
+void HLoadStoreElimination::KillMaps(State* state, HValue* object) {
+  if (object == NULL) {
+    state->maps.Rewind(0);
+    return;
+  }
+  for (int i = state->maps.length() - 1; i >= 0; --i) {
+    if (MayAlias(state->maps[i].object, object)) state->maps.Remove(i);
+  }
+}
+
+
+void HLoadStoreElimination::AddField(State* state,
+                                     HValue* object,
+                                     bool is_in_object,
+                                     int offset,
+                                     HValue* value) {
+  FieldEntry entry = { object, is_in_object, offset, value };
+  state->fields.Add(entry, zone_);
+}
+
+
+void HLoadStoreElimination::AddMaps(State* state,
+                                    HValue* object,
+                                    SmallMapList* maps,
+                                    HCheckMaps* check) {
+  MapsEntry entry = { object, maps, check };
+  int index = FindMaps(state, object);
+  if (index >= 0) {
+    state->maps[index] = entry;
+  } else {
+    state->maps.Add(entry, zone_);
+  }
+}
+
+
+bool HLoadStoreElimination::MayAlias(HValue* a, HValue* b) {
+  if (a == b) return true;
+  // Two different allocations are always different objects.
+  bool a_is_allocation = a->IsAllocate() || a->IsAllocateObject();
+  bool b_is_allocation = b->IsAllocate() || b->IsAllocateObject();
+  return !a_is_allocation || !b_is_allocation;
+}
+
+
+bool HLoadStoreElimination::ContainsMap(SmallMapList* maps, Handle<Map> map) {
+  for (int i = 0; i < maps->length(); ++i) {
+    if (*maps->at(i) == *map) return true;
+  }
+  return false;
+}
+
+
+bool HLoadStoreElimination::IsSubset(SmallMapList* maps,
+                                     SmallMapList* other) {
+  for (int i = 0; i < maps->length(); ++i) {
+    if (!ContainsMap(other, maps->at(i))) return false;
+  }
+  return true;
+}
+
+
 // Simple sparse set with O(1) add, contains, and clear.
 class SparseSet {
  public:
@@ -4879,12 +5769,20 @@ bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
   if (FLAG_dead_code_elimination) {
     DeadCodeElimination("H_Eliminate early dead code");
   }
+
+  // Replace non-escaping allocations with their fields. This must happen
+  // before phis are collected because it introduces new phis.
+  if (FLAG_use_escape_analysis) {
+    HEscapeAnalysis escape_analysis(this);
+    escape_analysis.Analyze();
+  }
   CollectPhis();
 
   if (has_osr_loop_entry()) {
     const ZoneList<HPhi*>* phis = osr_loop_entry()->phis();
     for (int j = 0; j < phis->length(); j++) {
       HPhi* phi = phis->at(j);
+      if (!phi->HasMergedIndex()) continue;
       osr_values()->at(phi->merged_index())->set_incoming_value(phi);
     }
   }
@@ -4911,6 +5809,11 @@ bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
 
   if (FLAG_use_gvn) GlobalValueNumbering();
 
+  if (FLAG_use_load_elimination) {
+    HLoadStoreElimination load_store_elimination(this);
+    load_store_elimination.Analyze();
+  }
+
   if (FLAG_use_range) {
     HRangeAnalysis rangeAnalysis(this);
     rangeAnalysis.Analyze();
@@ -4922,6 +5825,9 @@ bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
   sce.Process();
 
   if (FLAG_idefs) SetupInformativeDefinitions();
+  if (FLAG_array_bounds_checks_hoisting && !FLAG_idefs) {
+    HoistBoundsChecksOutOfLoops();
+  }
   if (FLAG_array_bounds_checks_elimination && !FLAG_idefs) {
     EliminateRedundantBoundsChecks();
   }
@@ -5335,6 +6241,246 @@ void HGraph::EliminateRedundantBoundsChecks() {
 }
 
 
+// Returns the positive step of an update "phi + step" of a counting loop, or
+// zero if the update is not of that form.
+static int32_t InductionVariableStep(HPhi* phi, HValue* update) {
+  if (!update->IsAdd() || !update->representation().IsInteger32()) return 0;
+  HAdd* add = HAdd::cast(update);
+  HValue* step = NULL;
+  if (add->left() == phi) {
+    step = add->right();
+  } else if (add->right() == phi) {
+    step = add->left();
+  }
+  if (step == NULL || !step->IsConstant()) return 0;
+  HConstant* constant = HConstant::cast(step);
+  if (!constant->HasInteger32Value()) return 0;
+  int32_t value = constant->Integer32Value();
+  return value > 0 ? value : 0;
+}
+
+
+static bool IsLoopInvariant(HValue* value, HLoopInformation* loop) {
+  return !loop->blocks()->Contains(value->block());
+}
+
+
+// Materializes "value + offset" in front of the given instruction.
+static HValue* AddInt32Offset(HValue* value,
+                              int32_t offset,
+                              HValue* context,
+                              HInstruction* before) {
+  if (offset == 0) return value;
+  Zone* zone = before->block()->zone();
+  if (value->IsConstant() && HConstant::cast(value)->HasInteger32Value()) {
+    int64_t result =
+        static_cast<int64_t>(HConstant::cast(value)->Integer32Value()) + offset;
+    if (result >= kMinInt && result <= kMaxInt) {
+      HConstant* constant = new(zone) HConstant(
+          static_cast<int32_t>(result), Representation::Integer32());
+      constant->InsertBefore(before);
+      return constant;
+    }
+  }
+  HConstant* constant =
+      new(zone) HConstant(offset, Representation::Integer32());
+  constant->InsertBefore(before);
+  HInstruction* add = HAdd::New(zone, context, value, constant);
+  add->AssumeRepresentation(Representation::Integer32());
+  add->InsertBefore(before);
+  return add;
+}
+
+
+// Replaces the checks of an induction variable "i" of a counting loop
+// "for (i = init; i < limit; i += step)" with checks in the loop pre-header
+// that cover all values the index takes in the loop. A failing hoisted check
+// deoptimizes once before the loop is entered instead of in some iteration.
+void HGraph::HoistBoundsChecksOutOfLoop(HLoopInformation* loop) {
+  HBasicBlock* header = loop->loop_header();
+  const ZoneList<HBasicBlock*>* predecessors = header->predecessors();
+  if (predecessors->length() != 2) return;
+  if (header->end() == NULL || !header->end()->IsCompareIDAndBranch()) return;
+  HCompareIDAndBranch* compare = HCompareIDAndBranch::cast(header->end());
+  if (!compare->representation().IsInteger32()) return;
+
+  // The loop must be left when the condition does not hold.
+  HBasicBlock* body = compare->SuccessorAt(0);
+  if (!loop->blocks()->Contains(body) ||
+      loop->blocks()->Contains(compare->SuccessorAt(1))) {
+    return;
+  }
+
+  Token::Value token = compare->token();
+  HValue* induction = compare->left();
+  HValue* limit = compare->right();
+  if (token == Token::GT || token == Token::GTE) {
+    token = Token::ReverseCompareOp(token);
+    induction = compare->right();
+    limit = compare->left();
+  }
+  if (token != Token::LT && token != Token::LTE) return;
+  if (!induction->IsPhi() || induction->block() != header) return;
+  if (!IsLoopInvariant(limit, loop)) return;
+
+  HPhi* phi = HPhi::cast(induction);
+  if (!phi->representation().IsInteger32()) return;
+  int entry_index = loop->blocks()->Contains(predecessors->at(0)) ? 1 : 0;
+  HBasicBlock* pre_header = predecessors->at(entry_index);
+  HValue* init = phi->OperandAt(entry_index);
+  HValue* update = phi->OperandAt(1 - entry_index);
+  if (InductionVariableStep(phi, update) == 0) return;
+  HValue* context = HAdd::cast(update)->context();
+
+  // The hoisted checks assume that the loop runs until the header test
+  // fails. A loop that can be left earlier, e.g. through "break" or
+  // "return", may never reach the indices the hoisted checks would reject,
+  // and would then deoptimize on every entry.
+  const ZoneList<HBasicBlock*>* loop_blocks = loop->blocks();
+  for (int i = 0; i < loop_blocks->length(); ++i) {
+    HBasicBlock* block = loop_blocks->at(i);
+    if (block == header) continue;
+    HControlInstruction* end = block->end();
+    if (end == NULL || end->SuccessorCount() == 0) return;
+    for (HSuccessorIterator it(end); !it.Done(); it.Advance()) {
+      if (!loop_blocks->Contains(it.Current())) return;
+    }
+  }
+
+  // Inside the body the index lies in [init, limit) (or [init, limit] for
+  // "<="), provided the body is entered at all.
+  int32_t limit_adjust = token == Token::LTE ? 1 : 0;
+  HInstruction* insert_before = pre_header->end();
+  ZoneList<HBoundsCheck*> hoisted(4, zone());
+  ZoneList<int32_t> hoisted_offsets(4, zone());
+
+  // Only checks that are executed in every iteration may be hoisted, so the
+  // block holding them has to dominate all back edges. A check in a
+  // conditionally executed block could fail in the pre-header although the
+  // loop never reaches it with an out of bounds index.
+  const ZoneList<HBasicBlock*>* back_edges = loop->back_edges();
+  for (int i = 0; i < loop_blocks->length(); ++i) {
+    HBasicBlock* block = loop_blocks->at(i);
+    if (block == header) continue;
+    bool executed_in_every_iteration = true;
+    for (int j = 0; j < back_edges->length(); ++j) {
+      HBasicBlock* back_edge = back_edges->at(j);
+      if (block != back_edge && !block->Dominates(back_edge)) {
+        executed_in_every_iteration = false;
+        break;
+      }
+    }
+    if (!executed_in_every_iteration) continue;
+    HInstruction* instr = block->first();
+    while (instr != NULL) {
+      HInstruction* next = instr->next();
+      if (!instr->IsBoundsCheck()) {
+        instr = next;
+        continue;
+      }
+      HBoundsCheck* check = HBoundsCheck::cast(instr);
+      instr = next;
+      if (check->skip_check() ||
+          !check->representation().IsInteger32() ||
+          !IsLoopInvariant(check->length(), loop)) {
+        continue;
+      }
+
+      int32_t offset = 0;
+      HValue* index = check->index();
+      if (index != phi) {
+        if (!index->IsAdd()) continue;
+        HAdd* add = HAdd::cast(index);
+        HValue* constant = NULL;
+        if (add->left() == phi) {
+          constant = add->right();
+        } else if (add->right() == phi) {
+          constant = add->left();
+        }
+        if (constant == NULL || !constant->IsConstant() ||
+            !HConstant::cast(constant)->HasInteger32Value()) {
+          continue;
+        }
+        offset = HConstant::cast(constant)->Integer32Value();
+      }
+
+      bool covered = false;
+      for (int j = 0; j < hoisted.length(); ++j) {
+        if (hoisted[j]->length() == check->length() &&
+            hoisted_offsets[j] == offset) {
+          covered = true;
+          break;
+        }
+      }
+
+      if (!covered) {
+        // Lower bound: the first index must not be negative.
+        if (init->IsConstant() && HConstant::cast(init)->HasInteger32Value()) {
+          int64_t first =
+              static_cast<int64_t>(HConstant::cast(init)->Integer32Value()) +
+              offset;
+          if (first < 0 || first > kMaxInt) continue;
+        } else {
+          HValue* first = AddInt32Offset(init, offset, context, insert_before);
+          HConstant* max_int =
+              new(zone()) HConstant(kMaxInt, Representation::Integer32());
+          max_int->InsertBefore(insert_before);
+          HBoundsCheck* lower = new(zone()) HBoundsCheck(
+              first, max_int, DONT_ALLOW_SMI_KEY,
+              Representation::Integer32());
+          lower->InsertBefore(insert_before);
+        }
+
+        // Upper bound: max(init, limit) + adjust + offset <= length. When
+        // the loop is not entered the limit can be below init, even
+        // negative, and the unsigned bounds check would reject it; the
+        // maximum keeps the end index from going negative. It is never
+        // below limit, so the check is at least as strict as one on limit.
+        if (limit != check->length() || offset + limit_adjust > 0) {
+          HValue* end = limit;
+          if (init != limit) {
+            HInstruction* max = HMathMinMax::New(
+                zone(), context, init, limit, HMathMinMax::kMathMax);
+            max->AssumeRepresentation(Representation::Integer32());
+            max->InsertBefore(insert_before);
+            end = max;
+          }
+          end = AddInt32Offset(end, offset + limit_adjust, context,
+                               insert_before);
+          HValue* length_plus_one =
+              AddInt32Offset(check->length(), 1, context, insert_before);
+          HBoundsCheck* upper = new(zone()) HBoundsCheck(
+              end, length_plus_one, DONT_ALLOW_SMI_KEY,
+              Representation::Integer32());
+          upper->InsertBefore(insert_before);
+        }
+
+        hoisted.Add(check, zone());
+        hoisted_offsets.Add(offset, zone());
+      }
+
+      if (FLAG_trace_bounds_checks_hoisting) {
+        PrintF("Hoisted bounds check #%d out of loop B%d\n",
+               check->id(), header->block_id());
+      }
+      isolate()->counters()->bounds_checks_hoisted()->Increment();
+      check->DeleteAndReplaceWith(check->ActualValue());
+    }
+  }
+}
+
+
+void HGraph::HoistBoundsChecksOutOfLoops() {
+  HPhase phase("H_Hoist bounds checks", this);
+  for (int i = 0; i < blocks()->length(); ++i) {
+    HBasicBlock* block = blocks()->at(i);
+    if (block->IsLoopHeader()) {
+      HoistBoundsChecksOutOfLoop(block->loop_information());
+    }
+  }
+}
+
+
 static void DehoistArrayIndex(ArrayInstructionInterface* array_operation) {
   HValue* index = array_operation->GetKey()->ActualValue();
   if (!index->representation().IsInteger32()) return;
@@ -5496,7 +6642,9 @@ void HGraph::RemoveDeadInstructions() {
     HPhi* phi = dead_phis.RemoveLast();
     HBasicBlock* block = phi->block();
     phi->DeleteAndReplaceWith(NULL);
-    block->RecordDeletedPhi(phi->merged_index());
+    if (phi->HasMergedIndex()) {
+      block->RecordDeletedPhi(phi->merged_index());
+    }
   }
 }
 
@@ -282,6 +282,7 @@ class HGraph: public ZoneObject {
   void AssignDominators();
   void SetupInformativeDefinitions();
   void EliminateRedundantBoundsChecks();
+  void HoistBoundsChecksOutOfLoops();
   void DehoistSimpleArrayIndexComputations();
   void RestoreActualValues();
   void DeadCodeElimination(const char *phase_name);
@@ -427,6 +428,7 @@ class HGraph: public ZoneObject {
   void SetupInformativeDefinitionsInBlock(HBasicBlock* block);
   void SetupInformativeDefinitionsRecursively(HBasicBlock* block);
   void EliminateRedundantBoundsChecks(HBasicBlock* bb, BoundsCheckTable* table);
+  void HoistBoundsChecksOutOfLoop(HLoopInformation* loop);
 
   Isolate* isolate_;
   int next_block_id_;
@@ -628,7 +628,7 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   if (environment == NULL) return;
 
   // The translation includes one command per value in the environment.
-  int translation_size = environment->values()->length();
+  int translation_size = environment->translation_size();
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
@@ -692,8 +692,32 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
     }
   }
 
+  // Fields of captured objects follow the frame values.
+  int object_index = 0;
+  int field_index = translation_size;
   for (int i = 0; i < translation_size; ++i) {
     LOperand* value = environment->values()->at(i);
+    if (environment->HasCapturedObjectAt(i)) {
+      if (environment->ObjectIsDuplicateAt(object_index)) {
+        translation->DuplicateObject(
+            environment->ObjectDuplicateOfAt(object_index));
+      } else {
+        int length = environment->ObjectLengthAt(object_index);
+        translation->BeginCapturedObject(length);
+        for (int j = 0; j < length; ++j, ++field_index) {
+          AddToTranslation(translation,
+                           environment->values()->at(field_index),
+                           environment->HasTaggedValueAt(field_index),
+                           environment->HasUint32ValueAt(field_index),
+                           arguments_known,
+                           arguments_index,
+                           arguments_count);
+        }
+      }
+      object_index++;
+      continue;
+    }
+
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
     if (environment->spilled_registers() != NULL && value != NULL) {
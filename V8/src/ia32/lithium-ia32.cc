@@ -673,8 +673,10 @@ LInstruction* LChunkBuilder::DefineX87TOS(
 LInstruction* LChunkBuilder::AssignEnvironment(LInstruction* instr) {
   HEnvironment* hydrogen_env = current_block_->last_environment();
   int argument_index_accumulator = 0;
+  ZoneList<HValue*> objects_to_materialize(0, zone());
   instr->set_environment(CreateEnvironment(hydrogen_env,
-                                           &argument_index_accumulator));
+                                           &argument_index_accumulator,
+                                           &objects_to_materialize));
   return instr;
 }
 
@@ -885,7 +887,8 @@ void LChunkBuilder::DoBasicBlock(HBasicBlock* block, HBasicBlock* next_block) {
     HEnvironment* last_environment = pred->last_environment();
     for (int i = 0; i < block->phis()->length(); ++i) {
       HPhi* phi = block->phis()->at(i);
-      if (phi->merged_index() < last_environment->length()) {
+      if (phi->HasMergedIndex() &&
+          phi->merged_index() < last_environment->length()) {
         last_environment->SetValueAt(phi->merged_index(), phi);
       }
     }
@@ -970,11 +973,13 @@ void LChunkBuilder::VisitInstruction(HInstruction* current) {
 
 LEnvironment* LChunkBuilder::CreateEnvironment(
     HEnvironment* hydrogen_env,
-    int* argument_index_accumulator) {
+    int* argument_index_accumulator,
+    ZoneList<HValue*>* objects_to_materialize) {
   if (hydrogen_env == NULL) return NULL;
 
-  LEnvironment* outer =
-      CreateEnvironment(hydrogen_env->outer(), argument_index_accumulator);
+  LEnvironment* outer = CreateEnvironment(hydrogen_env->outer(),
+                                          argument_index_accumulator,
+                                          objects_to_materialize);
   BailoutId ast_id = hydrogen_env->ast_id();
   ASSERT(!ast_id.IsNone() ||
          hydrogen_env->frame_type() != JS_FUNCTION);
@@ -990,10 +995,16 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
                                hydrogen_env->entry(),
                                zone());
   int argument_index = *argument_index_accumulator;
+  int object_index = objects_to_materialize->length();
   for (int i = 0; i < value_count; ++i) {
     if (hydrogen_env->is_special_index(i)) continue;
 
     HValue* value = hydrogen_env->values()->at(i);
+    if (value->IsCapturedObject()) {
+      AddCapturedObject(result, HCapturedObject::cast(value),
+                        objects_to_materialize);
+      continue;
+    }
     LOperand* op = NULL;
     if (value->IsArgumentsObject()) {
       op = NULL;
@@ -1007,6 +1018,18 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
                      value->CheckFlag(HInstruction::kUint32));
   }
 
+  // The fields of objects captured for the first time in this environment
+  // follow the frame values.
+  for (int i = object_index; i < objects_to_materialize->length(); ++i) {
+    HValue* object = objects_to_materialize->at(i);
+    for (int j = 0; j < object->OperandCount(); ++j) {
+      HValue* value = object->OperandAt(j);
+      result->AddValue(UseAny(value),
+                       value->representation(),
+                       value->CheckFlag(HInstruction::kUint32));
+    }
+  }
+
   if (hydrogen_env->frame_type() == JS_FUNCTION) {
     *argument_index_accumulator = argument_index;
   }
@@ -1015,6 +1038,24 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
 }
 
 
+void LChunkBuilder::AddCapturedObject(
+    LEnvironment* result,
+    HCapturedObject* object,
+    ZoneList<HValue*>* objects_to_materialize) {
+  for (int i = 0; i < objects_to_materialize->length(); ++i) {
+    HCapturedObject* other =
+        HCapturedObject::cast(objects_to_materialize->at(i));
+    if (other->capture_id() == object->capture_id()) {
+      ASSERT(other == object);
+      result->AddDuplicateObject(i);
+      return;
+    }
+  }
+  objects_to_materialize->Add(object, zone());
+  result->AddNewObject(object->length());
+}
+
+
 LInstruction* LChunkBuilder::DoGoto(HGoto* instr) {
   return new(zone()) LGoto(instr->FirstSuccessor()->block_id());
 }
@@ -2588,6 +2629,14 @@ LInstruction* LChunkBuilder::DoCallStub(HCallStub* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoCapturedObject(HCapturedObject* instr) {
+  // There are no real uses of a captured object, it is only referenced from
+  // environments and rematerialized by the deoptimizer.
+  instr->ReplayEnvironment(current_block_->last_environment());
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoArgumentsObject(HArgumentsObject* instr) {
   // There are no real uses of the arguments object.
   // arguments.length and element access are supported directly on
@@ -920,18 +920,7 @@ void IncrementalMarking::Step(intptr_t allocated_bytes,
     start = OS::TimeCurrentMillis();
   }
 
-  if (state_ == SWEEPING) {
-    if (heap_->EnsureSweepersProgressed(static_cast<int>(bytes_to_process))) {
-      bytes_scanned_ = 0;
-      StartMarking(PREVENT_COMPACTION);
-    }
-  } else if (state_ == MARKING) {
-    ProcessMarkingDeque(bytes_to_process);
-    if (marking_deque_.IsEmpty()) MarkingComplete(action);
-  }
-
-  steps_count_++;
-  steps_count_since_last_gc_++;
+  ProcessStepWork(bytes_to_process, action);
 
   bool speed_up = false;
 
@@ -998,13 +987,67 @@ void IncrementalMarking::Step(intptr_t allocated_bytes,
 
   if (FLAG_trace_incremental_marking || FLAG_trace_gc ||
       FLAG_print_cumulative_gc_stat) {
-    double end = OS::TimeCurrentMillis();
-    double delta = (end - start);
-    longest_step_ = Max(longest_step_, delta);
-    steps_took_ += delta;
-    steps_took_since_last_gc_ += delta;
-    heap_->AddMarkingTime(delta);
+    RecordStepTime(start);
+  }
+}
+
+
+bool IncrementalMarking::IdleStep(intptr_t bytes_to_process) {
+  if (heap_->gc_state() != Heap::NOT_IN_GC ||
+      !FLAG_incremental_marking ||
+      !FLAG_incremental_marking_steps ||
+      (state_ != SWEEPING && state_ != MARKING)) {
+    return false;
+  }
+
+  if (state_ == MARKING && no_marking_scope_depth_ > 0) return false;
+
+  // Idle steps don't feed the marking speed heuristics above: those
+  // react to the mutator outrunning the marker, which is not happening
+  // while the embedder is idle.
+  bytes_scanned_ += bytes_to_process;
+
+  double start = 0;
+
+  if (FLAG_trace_incremental_marking || FLAG_trace_gc ||
+      FLAG_print_cumulative_gc_stat) {
+    start = OS::TimeCurrentMillis();
+  }
+
+  ProcessStepWork(bytes_to_process, NO_GC_VIA_STACK_GUARD);
+
+  if (FLAG_trace_incremental_marking || FLAG_trace_gc ||
+      FLAG_print_cumulative_gc_stat) {
+    RecordStepTime(start);
   }
+  return true;
+}
+
+
+void IncrementalMarking::ProcessStepWork(intptr_t bytes_to_process,
+                                         CompletionAction action) {
+  if (state_ == SWEEPING) {
+    if (heap_->EnsureSweepersProgressed(static_cast<int>(bytes_to_process))) {
+      bytes_scanned_ = 0;
+      StartMarking(PREVENT_COMPACTION);
+    }
+  } else if (state_ == MARKING) {
+    ProcessMarkingDeque(bytes_to_process);
+    if (marking_deque_.IsEmpty()) MarkingComplete(action);
+  }
+
+  steps_count_++;
+  steps_count_since_last_gc_++;
+}
+
+
+void IncrementalMarking::RecordStepTime(double start) {
+  double end = OS::TimeCurrentMillis();
+  double delta = (end - start);
+  longest_step_ = Max(longest_step_, delta);
+  steps_took_ += delta;
+  steps_took_since_last_gc_ += delta;
+  heap_->AddMarkingTime(delta);
 }
 
 
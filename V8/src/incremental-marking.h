@@ -116,6 +116,12 @@ class IncrementalMarking {
 
   void Step(intptr_t allocated, CompletionAction action);
 
+  // Processes about the given amount of marking (or sweeping) work
+  // independently of the allocation rate. Used when the embedder reports
+  // idle time; completion never goes through the stack guard. Returns
+  // false if no step could be taken.
+  bool IdleStep(intptr_t bytes_to_process);
+
   inline void RestartIfNotMarking() {
     if (state_ == COMPLETE) {
       state_ = MARKING;
@@ -225,6 +231,9 @@ class IncrementalMarking {
 
   void ResetStepCounters();
 
+  void ProcessStepWork(intptr_t bytes_to_process, CompletionAction action);
+  void RecordStepTime(double start);
+
   void StartMarking(CompactionFlag flag);
 
   void ActivateIncrementalWriteBarrier(PagedSpace* space);
@@ -289,7 +289,11 @@ int RegExpImpl::AtomExecRaw(Handle<JSRegExp> regexp,
   ASSERT(0 <= index);
   ASSERT(index <= subject->length());
 
-  if (!subject->IsFlat()) FlattenString(subject);
+  if (!subject->IsFlat()) {
+    isolate->counters()->string_flatten_regexp()->Increment(
+        subject->length());
+    FlattenString(subject);
+  }
   AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
 
   String* needle = String::cast(regexp->DataAt(JSRegExp::kAtomPatternIndex));
@@ -527,7 +531,11 @@ void RegExpImpl::IrregexpInitialize(Handle<JSRegExp> re,
 
 int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
                                 Handle<String> subject) {
-  if (!subject->IsFlat()) FlattenString(subject);
+  if (!subject->IsFlat()) {
+    regexp->GetIsolate()->counters()->string_flatten_regexp()->Increment(
+        subject->length());
+    FlattenString(subject);
+  }
 
   // Check the asciiness of the underlying storage.
   bool is_ascii = subject->IsOneByteRepresentationUnderneath();
@@ -530,8 +530,9 @@ class LEnvironment: public ZoneObject {
         parameter_count_(parameter_count),
         pc_offset_(-1),
         values_(value_count, zone),
-        is_tagged_(value_count, zone),
-        is_uint32_(value_count, zone),
+        is_captured_(value_count, zone),
+        object_mapping_(0, zone),
+        object_field_count_(0),
         spilled_registers_(NULL),
         spilled_double_registers_(NULL),
         outer_(outer),
@@ -560,14 +561,57 @@ class LEnvironment: public ZoneObject {
     values_.Add(operand, zone());
     if (representation.IsTagged()) {
       ASSERT(!is_uint32);
-      is_tagged_.Add(values_.length() - 1);
+      is_tagged_.Add(values_.length() - 1, zone());
     }
 
     if (is_uint32) {
-      is_uint32_.Add(values_.length() - 1);
+      is_uint32_.Add(values_.length() - 1, zone());
     }
   }
 
+  // Captured objects are represented by a NULL marker among the frame values.
+  // The field values of newly captured objects are added after all frame
+  // values, in the order the objects appear in the frame.
+  void AddNewObject(int length) {
+    values_.Add(NULL, zone());
+    is_captured_.Add(values_.length() - 1);
+    object_mapping_.Add(LengthOrDupeField::encode(length) |
+                        IsDuplicateField::encode(false), zone());
+    object_field_count_ += length;
+  }
+
+  // Refers to an object captured earlier, either in this or in an outer
+  // environment. Objects are numbered in order of their first appearance.
+  void AddDuplicateObject(int dupe_of) {
+    values_.Add(NULL, zone());
+    is_captured_.Add(values_.length() - 1);
+    object_mapping_.Add(LengthOrDupeField::encode(dupe_of) |
+                        IsDuplicateField::encode(true), zone());
+  }
+
+  bool HasCapturedObjectAt(int index) const {
+    return is_captured_.Contains(index);
+  }
+
+  int ObjectLengthAt(int object_index) const {
+    ASSERT(!ObjectIsDuplicateAt(object_index));
+    return LengthOrDupeField::decode(object_mapping_[object_index]);
+  }
+
+  int ObjectDuplicateOfAt(int object_index) const {
+    ASSERT(ObjectIsDuplicateAt(object_index));
+    return LengthOrDupeField::decode(object_mapping_[object_index]);
+  }
+
+  bool ObjectIsDuplicateAt(int object_index) const {
+    return IsDuplicateField::decode(object_mapping_[object_index]);
+  }
+
+  // Number of values that correspond to slots in the output frame.
+  int translation_size() const {
+    return values_.length() - object_field_count_;
+  }
+
   bool HasTaggedValueAt(int index) const {
     return is_tagged_.Contains(index);
   }
@@ -607,9 +651,15 @@ class LEnvironment: public ZoneObject {
   BailoutId ast_id_;
   int parameter_count_;
   int pc_offset_;
+  class LengthOrDupeField : public BitField<int, 0, 31> { };
+  class IsDuplicateField : public BitField<bool, 31, 1> { };
+
   ZoneList<LOperand*> values_;
-  BitVector is_tagged_;
-  BitVector is_uint32_;
+  GrowableBitVector is_tagged_;
+  GrowableBitVector is_uint32_;
+  BitVector is_captured_;
+  ZoneList<uint32_t> object_mapping_;
+  int object_field_count_;
 
   // Allocation index indexed arrays of spill slot operands for registers
   // that are also in spill slots at an OSR entry.  NULL for environments
@@ -47,6 +47,7 @@ MarkBit Marking::MarkBitFrom(Address addr) {
 void MarkCompactCollector::SetFlags(int flags) {
   sweep_precisely_ = ((flags & Heap::kSweepPreciselyMask) != 0);
   reduce_memory_footprint_ = ((flags & Heap::kReduceMemoryFootprintMask) != 0);
+  compact_sparse_pages_ = ((flags & Heap::kCompactSparsePagesMask) != 0);
   abort_incremental_marking_ =
       ((flags & Heap::kAbortIncrementalMarkingMask) != 0);
 }
@@ -62,6 +62,7 @@ MarkCompactCollector::MarkCompactCollector() :  // NOLINT
 #endif
       sweep_precisely_(false),
       reduce_memory_footprint_(false),
+      compact_sparse_pages_(false),
       abort_incremental_marking_(false),
       marking_parity_(ODD_MARKING_PARITY),
       compacting_(false),
@@ -772,6 +773,13 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
     max_evacuation_candidates *= 2;
   }
 
+  if (compact_sparse_pages_) {
+    // The isolate is going idle, so pause time matters less than memory:
+    // evacuate every sparse page regardless of the estimated release.
+    mode = REDUCE_MEMORY_FOOTPRINT;
+    max_evacuation_candidates = kMaxMaxEvacuationCandidates;
+  }
+
   if (FLAG_trace_fragmentation && mode == REDUCE_MEMORY_FOOTPRINT) {
     PrintF("Estimated over reserved memory: %.1f / %.1f MB (threshold %d)\n",
            static_cast<double>(over_reserved) / MB,
@@ -803,7 +811,8 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
       if ((counter & 1) == (page_number & 1)) fragmentation = 1;
     } else if (mode == REDUCE_MEMORY_FOOTPRINT) {
       // Don't try to release too many pages.
-      if (estimated_release >= ((over_reserved * 3) / 4)) {
+      if (!compact_sparse_pages_ &&
+          estimated_release >= ((over_reserved * 3) / 4)) {
         continue;
       }
 
@@ -2948,6 +2957,7 @@ void MarkCompactCollector::EvacuatePages() {
           page->ClearEvacuationCandidate();
           page->SetFlag(Page::RESCAN_ON_EVACUATION);
           page->InsertAfter(static_cast<PagedSpace*>(page->owner())->anchor());
+          static_cast<PagedSpace*>(page->owner())->RecordPageOccupancy(page);
         }
         return;
       }
@@ -3870,6 +3880,7 @@ void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
                                       sweeper == PARALLEL_CONSERVATIVE ||
                                       sweeper == CONCURRENT_CONSERVATIVE);
   space->ClearStats();
+  space->ResetPageOccupancy();
 
   PageIterator it(space);
 
@@ -3891,12 +3902,15 @@ void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
     if (p->IsFlagSet(Page::RESCAN_ON_EVACUATION)) {
       // Will be processed in EvacuateNewSpaceAndCandidates.
       ASSERT(evacuation_candidates_.length() > 0);
+      space->RecordPageOccupancy(p);
       continue;
     }
 
     // One unused page is kept, all further are released before sweeping them.
+    // When compacting sparse pages only the first page of the space is kept.
     if (p->LiveBytes() == 0) {
-      if (unused_page_present) {
+      if (unused_page_present ||
+          (compact_sparse_pages_ && p != space->FirstPage())) {
         if (FLAG_gc_verbose) {
           PrintF("Sweeping 0x%" V8PRIxPTR " released page.\n",
                  reinterpret_cast<intptr_t>(p));
@@ -3910,6 +3924,10 @@ void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
       unused_page_present = true;
     }
 
+    // Sweeping resets the live byte count, so the occupancy of the pages
+    // that are kept has to be recorded first.
+    space->RecordPageOccupancy(p);
+
     switch (sweeper) {
       case CONSERVATIVE: {
         if (FLAG_gc_verbose) {
@@ -4041,6 +4059,10 @@ void MarkCompactCollector::SweepSpaces() {
 
   // Deallocate evacuated candidate pages.
   ReleaseEvacuationCandidates();
+
+  for (int i = FIRST_PAGED_SPACE; i <= LAST_PAGED_SPACE; i++) {
+    heap()->paged_space(i)->FinishPageOccupancy();
+  }
 }
 
 
@@ -770,6 +770,8 @@ class MarkCompactCollector {
 
   bool reduce_memory_footprint_;
 
+  bool compact_sparse_pages_;
+
   bool abort_incremental_marking_;
 
   MarkingParity marking_parity_;
@@ -736,6 +736,10 @@ void JSArrayBuffer::JSArrayBufferVerify() {
   VerifyPointer(byte_length());
   CHECK(byte_length()->IsSmi() || byte_length()->IsHeapNumber()
         || byte_length()->IsUndefined());
+  VerifyPointer(weak_next());
+  VerifyPointer(weak_first_view());
+  CHECK(weak_first_view()->IsJSTypedArray()
+        || weak_first_view()->IsUndefined());
 }
 
 
@@ -757,6 +761,9 @@ void JSTypedArray::JSTypedArrayVerify() {
   CHECK(length()->IsSmi() || length()->IsHeapNumber()
         || length()->IsUndefined());
 
+  VerifyPointer(weak_next());
+  CHECK(weak_next()->IsJSTypedArray() || weak_next()->IsUndefined());
+
   VerifyPointer(elements());
 }
 
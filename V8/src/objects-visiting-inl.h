@@ -85,6 +85,10 @@ void StaticNewSpaceVisitor<StaticVisitor>::Initialize() {
 
   table_.Register(kVisitJSRegExp, &JSObjectVisitor::Visit);
 
+  table_.Register(kVisitJSArrayBuffer, &VisitJSArrayBuffer);
+
+  table_.Register(kVisitJSTypedArray, &VisitJSTypedArray);
+
   table_.template RegisterSpecializations<DataObjectVisitor,
                                           kVisitDataObject,
                                           kVisitDataObjectGeneric>();
@@ -98,6 +102,40 @@ void StaticNewSpaceVisitor<StaticVisitor>::Initialize() {
 }
 
 
+template<typename StaticVisitor>
+int StaticNewSpaceVisitor<StaticVisitor>::VisitJSArrayBuffer(
+    Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  // The weak list fields are not visited. They are updated when the heap
+  // processes its weak references at the end of the scavenge.
+  VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSArrayBuffer::kPropertiesOffset),
+      HeapObject::RawField(object, JSArrayBuffer::kWeakNextOffset));
+  VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSArrayBuffer::kSize),
+      HeapObject::RawField(object, map->instance_size()));
+  return map->instance_size();
+}
+
+
+template<typename StaticVisitor>
+int StaticNewSpaceVisitor<StaticVisitor>::VisitJSTypedArray(
+    Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSTypedArray::kPropertiesOffset),
+      HeapObject::RawField(object, JSTypedArray::kWeakNextOffset));
+  VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSTypedArray::kSize),
+      HeapObject::RawField(object, map->instance_size()));
+  return map->instance_size();
+}
+
+
 template<typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::Initialize() {
   table_.Register(kVisitShortcutCandidate,
@@ -151,6 +189,10 @@ void StaticMarkingVisitor<StaticVisitor>::Initialize() {
 
   // Registration for kVisitJSRegExp is done by StaticVisitor.
 
+  table_.Register(kVisitJSArrayBuffer, &VisitJSArrayBuffer);
+
+  table_.Register(kVisitJSTypedArray, &VisitJSTypedArray);
+
   table_.Register(kVisitPropertyCell,
                   &FixedBodyVisitor<StaticVisitor,
                   JSGlobalPropertyCell::BodyDescriptor,
@@ -400,6 +442,38 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSRegExp(
 }
 
 
+template<typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitJSArrayBuffer(
+    Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  // Array buffers and their views are linked into weak lists, so the list
+  // fields are skipped here and cleared by the heap once marking is done.
+  StaticVisitor::VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSArrayBuffer::kPropertiesOffset),
+      HeapObject::RawField(object, JSArrayBuffer::kWeakNextOffset));
+  StaticVisitor::VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSArrayBuffer::kSize),
+      HeapObject::RawField(object, map->instance_size()));
+}
+
+
+template<typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitJSTypedArray(
+    Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  StaticVisitor::VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSTypedArray::kPropertiesOffset),
+      HeapObject::RawField(object, JSTypedArray::kWeakNextOffset));
+  StaticVisitor::VisitPointers(
+      heap,
+      HeapObject::RawField(object, JSTypedArray::kSize),
+      HeapObject::RawField(object, map->instance_size()));
+}
+
+
 template<typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::MarkMapContents(
     Heap* heap, Map* map) {
@@ -1040,6 +1040,103 @@ static bool AnWord(String* str) {
 }
 
 
+// Turns a cons string into a slice of the builder backing store that now
+// holds its characters. Both shapes have the same size and field layout, so
+// this cannot fail and keeps the identity and hash of the string.
+static void MorphConsIntoBuilderSlice(Heap* heap,
+                                      ConsString* cons,
+                                      String* store) {
+  STATIC_ASSERT(ConsString::kSize == SlicedString::kSize);
+  STATIC_ASSERT(ConsString::kFirstOffset == SlicedString::kParentOffset);
+  STATIC_ASSERT(ConsString::kSecondOffset == SlicedString::kOffsetOffset);
+  ASSERT(cons->IsOneByteRepresentation() == store->IsOneByteRepresentation());
+  cons->set_map(cons->IsOneByteRepresentation()
+                    ? heap->sliced_ascii_string_map()
+                    : heap->sliced_string_map());
+  SlicedString* slice = SlicedString::cast(cons);
+  slice->set_parent(store);
+  slice->set_offset(0);
+}
+
+
+// Flattens strings that are being built by repeated concatenation into a
+// backing store that later appends can fill in place. Returns NULL if the
+// string does not look like it is being built up this way.
+static MaybeObject* FlattenIntoStringBuilder(Heap* heap,
+                                             ConsString* cons,
+                                             PretenureFlag tenure) {
+  int length = cons->length();
+  bool is_one_byte = cons->IsOneByteRepresentation();
+
+  // Find the string that the concatenations started from.
+  int depth = 0;
+  String* leftmost = cons->first();
+  while (leftmost->IsConsString()) {
+    leftmost = ConsString::cast(leftmost)->first();
+    depth++;
+  }
+
+  // Only a slice that covers exactly the characters in use of a backing
+  // store in the cache is a builder. Other slices at offset zero are plain
+  // substrings.
+  bool is_builder_slice = false;
+  if (leftmost->IsSlicedString()) {
+    SlicedString* slice = SlicedString::cast(leftmost);
+    String* store = slice->parent();
+    int used_length = slice->length();
+    is_builder_slice = slice->offset() == 0 &&
+        store->IsSeqString() &&
+        store->IsOneByteRepresentation() == is_one_byte &&
+        StringBuilderCache::Lookup(heap, store) == used_length;
+    if (is_builder_slice && store->length() >= length) {
+      if (is_one_byte) {
+        uint8_t* dest = SeqOneByteString::cast(store)->GetChars();
+        String::WriteToFlat(cons, dest + used_length, used_length, length);
+      } else {
+        uc16* dest = SeqTwoByteString::cast(store)->GetChars();
+        String::WriteToFlat(cons, dest + used_length, used_length, length);
+      }
+      Counters* counters = heap->isolate()->counters();
+      counters->string_builder_appends()->Increment();
+      counters->string_flatten_chars()->Increment(length - used_length);
+      StringBuilderCache::Enter(heap, store, length);
+      MorphConsIntoBuilderSlice(heap, cons, store);
+      return cons;
+    }
+  }
+
+  // A single concatenation is flattened into an exactly sized string. A
+  // longer chain starts a builder, but its store is still exactly sized;
+  // only a builder that is appended to again and has run out of space gets
+  // a store with room to grow. Strings flattened once never carry slack.
+  if (depth == 0 && !is_builder_slice) return NULL;
+
+  int capacity = is_builder_slice ? Min(length * 2, String::kMaxLength)
+                                  : length;
+  Object* object;
+  if (is_one_byte) {
+    MaybeObject* maybe_object =
+        heap->AllocateRawOneByteString(capacity, tenure);
+    if (!maybe_object->ToObject(&object)) return maybe_object;
+    uint8_t* dest = SeqOneByteString::cast(object)->GetChars();
+    String::WriteToFlat(cons, dest, 0, length);
+  } else {
+    MaybeObject* maybe_object =
+        heap->AllocateRawTwoByteString(capacity, tenure);
+    if (!maybe_object->ToObject(&object)) return maybe_object;
+    uc16* dest = SeqTwoByteString::cast(object)->GetChars();
+    String::WriteToFlat(cons, dest, 0, length);
+  }
+  String* store = String::cast(object);
+  Counters* counters = heap->isolate()->counters();
+  counters->string_builder_allocations()->Increment();
+  counters->string_flatten_chars()->Increment(length);
+  StringBuilderCache::Enter(heap, store, length);
+  MorphConsIntoBuilderSlice(heap, cons, store);
+  return cons;
+}
+
+
 MaybeObject* String::SlowTryFlatten(PretenureFlag pretenure) {
 #ifdef DEBUG
   // Do not attempt to flatten in debug mode when allocation is not
@@ -1061,6 +1158,12 @@ MaybeObject* String::SlowTryFlatten(PretenureFlag pretenure) {
       // an old space GC.
       PretenureFlag tenure = heap->InNewSpace(this) ? pretenure : TENURED;
       int len = length();
+      if (FLAG_string_slices && len >= StringBuilderCache::kMinLength) {
+        MaybeObject* builder_result =
+            FlattenIntoStringBuilder(heap, cs, tenure);
+        if (builder_result != NULL) return builder_result;
+      }
+      heap->isolate()->counters()->string_flatten_chars()->Increment(len);
       Object* object;
       String* result;
       if (IsOneByteRepresentation()) {
@@ -10385,6 +10488,18 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(FILE* out) {
                  args_index, args_length, args_known);
           break;
         }
+
+        case Translation::CAPTURED_OBJECT: {
+          int length = iterator.Next();
+          PrintF(out, "{length=%d}", length);
+          break;
+        }
+
+        case Translation::DUPLICATED_OBJECT: {
+          int object_index = iterator.Next();
+          PrintF(out, "{object_index=%d}", object_index);
+          break;
+        }
       }
       PrintF(out, "\n");
     }
@@ -13760,6 +13875,26 @@ size_t JSTypedArray::element_size() {
 }
 
 
+void JSArrayBuffer::Neuter() {
+  Object* view = weak_first_view();
+  while (!view->IsUndefined()) {
+    JSTypedArray* typed_array = JSTypedArray::cast(view);
+    typed_array->Neuter();
+    view = typed_array->weak_next();
+  }
+  set_backing_store(NULL);
+  set_byte_length(Smi::FromInt(0));
+}
+
+
+void JSTypedArray::Neuter() {
+  set_byte_offset(Smi::FromInt(0));
+  set_byte_length(Smi::FromInt(0));
+  set_length(Smi::FromInt(0));
+  set_elements(GetHeap()->EmptyExternalArrayForMap(map()));
+}
+
+
 Object* ExternalPixelArray::SetValue(uint32_t index, Object* value) {
   uint8_t clamped_value = 0;
   if (index < static_cast<uint32_t>(length())) {
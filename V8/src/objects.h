@@ -8756,16 +8756,46 @@ class JSArrayBuffer: public JSObject {
   // [byte_length]: length in bytes
   DECL_ACCESSORS(byte_length, Object)
 
+  // [flag]: info flags encoded as Smi.
+  inline int flag();
+  inline void set_flag(int value);
+
+  // [is_external]: true if the backing store is owned by the embedder and
+  // must never be freed by V8.
+  inline bool is_external();
+  inline void set_is_external(bool value);
+
+  // [release_info]: describes how to free a backing store that the embedder
+  // handed over together with a release callback, NULL otherwise.
+  DECL_ACCESSORS(release_info, void)
+
+  // [weak_next]: linked list of array buffers.
+  DECL_ACCESSORS(weak_next, Object)
+
+  // [weak_first_view]: weak linked list of typed arrays viewing this buffer.
+  DECL_ACCESSORS(weak_first_view, Object)
+
   // Casting.
   static inline JSArrayBuffer* cast(Object* obj);
 
+  // Detaches the backing store from this buffer and from all its views,
+  // leaving them with zero length. Ownership of the memory is not touched.
+  void Neuter();
+
   // Dispatched behavior.
   DECLARE_PRINTER(JSArrayBuffer)
   DECLARE_VERIFIER(JSArrayBuffer)
 
   static const int kBackingStoreOffset = JSObject::kHeaderSize;
   static const int kByteLengthOffset = kBackingStoreOffset + kPointerSize;
-  static const int kSize = kByteLengthOffset + kPointerSize;
+  static const int kFlagOffset = kByteLengthOffset + kPointerSize;
+  static const int kReleaseInfoOffset = kFlagOffset + kPointerSize;
+  static const int kWeakNextOffset = kReleaseInfoOffset + kPointerSize;
+  static const int kWeakFirstViewOffset = kWeakNextOffset + kPointerSize;
+  static const int kSize = kWeakFirstViewOffset + kPointerSize;
+
+  // Bit position in the flag, from least significant bit position.
+  static const int kIsExternalBit = 0;
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSArrayBuffer);
@@ -8786,12 +8816,18 @@ class JSTypedArray: public JSObject {
   // [length]: length of typed array in elements.
   DECL_ACCESSORS(length, Object)
 
+  // [weak_next]: linked list of typed arrays over the same array buffer.
+  DECL_ACCESSORS(weak_next, Object)
+
   // Casting.
   static inline JSTypedArray* cast(Object* obj);
 
   ExternalArrayType type();
   size_t element_size();
 
+  // Drops this view's reference to the backing store of its buffer.
+  void Neuter();
+
   // Dispatched behavior.
   DECLARE_PRINTER(JSTypedArray)
   DECLARE_VERIFIER(JSTypedArray)
@@ -8800,7 +8836,8 @@ class JSTypedArray: public JSObject {
   static const int kByteOffsetOffset = kBufferOffset + kPointerSize;
   static const int kByteLengthOffset = kByteOffsetOffset + kPointerSize;
   static const int kLengthOffset = kByteLengthOffset + kPointerSize;
-  static const int kSize = kLengthOffset + kPointerSize;
+  static const int kWeakNextOffset = kLengthOffset + kPointerSize;
+  static const int kSize = kWeakNextOffset + kPointerSize;
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSTypedArray);
@@ -596,8 +596,130 @@ void CodeMap::Print() {
 }
 
 
+FoldedStacksTable::FoldedStacksTable(int max_unique_stacks)
+    : max_unique_stacks_(max_unique_stacks),
+      stacks_(StacksMatch),
+      dropped_samples_(0) {
+  ASSERT(max_unique_stacks > 0);
+}
+
+
+FoldedStacksTable::~FoldedStacksTable() {
+  Clear();
+}
+
+
+uint32_t FoldedStacksTable::StackHash(CodeEntry** frames, int depth) {
+  uint32_t hash = ComputeIntegerHash(depth, v8::internal::kZeroHashSeed);
+  for (int i = 0; i < depth; ++i) {
+    hash = hash * 31 + frames[i]->GetCallUid();
+  }
+  return hash;
+}
+
+
+bool FoldedStacksTable::StacksMatch(void* key1, void* key2) {
+  FoldedStack* stack1 = reinterpret_cast<FoldedStack*>(key1);
+  FoldedStack* stack2 = reinterpret_cast<FoldedStack*>(key2);
+  if (stack1->depth != stack2->depth) return false;
+  for (int i = 0; i < stack1->depth; ++i) {
+    if (!stack1->frames[i]->IsSameAs(stack2->frames[i])) return false;
+  }
+  return true;
+}
+
+
+void FoldedStacksTable::AddPath(const Vector<CodeEntry*>& path) {
+  // Drop unsymbolized frames and reverse the path, so that stacks which
+  // differ only in unknown frames fold together.
+  ScopedVector<CodeEntry*> frames(path.length());
+  int depth = 0;
+  for (int i = path.length() - 1; i >= 0; --i) {
+    if (path[i] != NULL) frames[depth++] = path[i];
+  }
+  if (depth == 0) return;
+
+  FoldedStack probe;
+  probe.depth = depth;
+  probe.count = 0;
+  probe.frames = frames.start();
+  uint32_t hash = StackHash(probe.frames, depth);
+  HashMap::Entry* map_entry = stacks_.Lookup(&probe, hash, false);
+  if (map_entry == NULL) {
+    if (unique_stacks() >= max_unique_stacks_) {
+      ++dropped_samples_;
+      return;
+    }
+    FoldedStack* stack = new FoldedStack;
+    stack->depth = depth;
+    stack->count = 0;
+    stack->frames = NewArray<CodeEntry*>(depth);
+    OS::MemCopy(stack->frames, probe.frames, depth * sizeof(*stack->frames));
+    map_entry = stacks_.Lookup(stack, hash, true);
+    map_entry->key = stack;
+  }
+  ++reinterpret_cast<FoldedStack*>(map_entry->key)->count;
+}
+
+
+static void AppendString(const char* str, List<char>* output) {
+  for (const char* c = str; *c != '\0'; ++c) {
+    // ';' separates frames and '\n' separates stacks in the folded format.
+    output->Add(*c == ';' || *c == '\n' ? '_' : *c);
+  }
+}
+
+
+void FoldedStacksTable::AppendFrameName(CodeEntry* entry, List<char>* output) {
+  AppendString(entry->name_prefix(), output);
+  AppendString(entry->name()[0] != '\0'
+                   ? entry->name()
+                   : ProfileGenerator::kAnonymousFunctionName,
+               output);
+  if (entry->resource_name()[0] != '\0') {
+    output->Add(' ');
+    AppendString(entry->resource_name(), output);
+    if (entry->line_number() != v8::CpuProfileNode::kNoLineNumberInfo) {
+      EmbeddedVector<char, 16> line;
+      OS::SNPrintF(line, ":%d", entry->line_number());
+      AppendString(line.start(), output);
+    }
+  }
+}
+
+
+unsigned FoldedStacksTable::SnapshotAndReset(List<char>* output) {
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    FoldedStack* stack = reinterpret_cast<FoldedStack*>(p->key);
+    for (int i = 0; i < stack->depth; ++i) {
+      if (i > 0) output->Add(';');
+      AppendFrameName(stack->frames[i], output);
+    }
+    EmbeddedVector<char, 16> count;
+    OS::SNPrintF(count, " %u", stack->count);
+    AppendString(count.start(), output);
+    output->Add('\n');
+  }
+  unsigned dropped_samples = dropped_samples_;
+  Clear();
+  return dropped_samples;
+}
+
+
+void FoldedStacksTable::Clear() {
+  for (HashMap::Entry* p = stacks_.Start(); p != NULL; p = stacks_.Next(p)) {
+    FoldedStack* stack = reinterpret_cast<FoldedStack*>(p->key);
+    DeleteArray(stack->frames);
+    delete stack;
+  }
+  stacks_.Clear();
+  dropped_samples_ = 0;
+}
+
+
 CpuProfilesCollection::CpuProfilesCollection()
     : profiles_uids_(UidsMatch),
+      folded_stacks_(NULL),
       current_profiles_semaphore_(OS::CreateSemaphore(1)) {
   // Create list of unabridged profiles.
   profiles_by_token_.Add(new List<CpuProfile*>());
@@ -621,6 +743,7 @@ static void DeleteProfilesList(List<CpuProfile*>** list_ptr) {
 
 CpuProfilesCollection::~CpuProfilesCollection() {
   delete current_profiles_semaphore_;
+  delete folded_stacks_;
   current_profiles_.Iterate(DeleteCpuProfile);
   detached_profiles_.Iterate(DeleteCpuProfile);
   profiles_by_token_.Iterate(DeleteProfilesList);
@@ -628,6 +751,21 @@ CpuProfilesCollection::~CpuProfilesCollection() {
 }
 
 
+void CpuProfilesCollection::DeleteAllProfiles() {
+  current_profiles_semaphore_->Wait();
+  current_profiles_.Iterate(DeleteCpuProfile);
+  current_profiles_.Clear();
+  current_profiles_semaphore_->Signal();
+  detached_profiles_.Iterate(DeleteCpuProfile);
+  detached_profiles_.Clear();
+  profiles_by_token_.Iterate(DeleteProfilesList);
+  profiles_by_token_.Clear();
+  profiles_uids_.Clear();
+  // Create list of unabridged profiles.
+  profiles_by_token_.Add(new List<CpuProfile*>());
+}
+
+
 bool CpuProfilesCollection::StartProfiling(const char* title, unsigned uid,
                                            bool record_samples) {
   ASSERT(uid > 0);
@@ -855,7 +993,39 @@ void CpuProfilesCollection::AddPathToCurrentProfiles(
   for (int i = 0; i < current_profiles_.length(); ++i) {
     current_profiles_[i]->AddPath(path);
   }
+  if (folded_stacks_ != NULL) folded_stacks_->AddPath(path);
+  current_profiles_semaphore_->Signal();
+}
+
+
+bool CpuProfilesCollection::StartFoldedStacks(int max_unique_stacks) {
+  // Called from VM thread, and only it can replace the table.
+  if (folded_stacks_ != NULL) return false;
+  FoldedStacksTable* table = new FoldedStacksTable(max_unique_stacks);
+  current_profiles_semaphore_->Wait();
+  folded_stacks_ = table;
+  current_profiles_semaphore_->Signal();
+  return true;
+}
+
+
+void CpuProfilesCollection::StopFoldedStacks() {
+  current_profiles_semaphore_->Wait();
+  FoldedStacksTable* table = folded_stacks_;
+  folded_stacks_ = NULL;
+  current_profiles_semaphore_->Signal();
+  delete table;
+}
+
+
+unsigned CpuProfilesCollection::SnapshotFoldedStacks(List<char>* output) {
+  unsigned dropped_samples = 0;
+  current_profiles_semaphore_->Wait();
+  if (folded_stacks_ != NULL) {
+    dropped_samples = folded_stacks_->SnapshotAndReset(output);
+  }
   current_profiles_semaphore_->Signal();
+  return dropped_samples;
 }
 
 
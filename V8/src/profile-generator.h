@@ -301,6 +301,48 @@ class CodeMap {
 };
 
 
+// Aggregates symbolized samples by unique call stack, the way flame graph
+// tools consume them. Unlike a CpuProfile it keeps no per-node tree and
+// no per-sample log, so its size is bounded by the number of distinct
+// stacks, which makes it suitable for continuous low-rate sampling.
+class FoldedStacksTable {
+ public:
+  explicit FoldedStacksTable(int max_unique_stacks);
+  ~FoldedStacksTable();
+
+  // Path is ordered from the sampled pc to the outermost caller and may
+  // contain NULL entries for frames that could not be symbolized.
+  void AddPath(const Vector<CodeEntry*>& path);
+  // Appends one "outermost;...;innermost count" line per unique stack
+  // and clears the table. Returns the number of samples dropped since
+  // the previous snapshot.
+  unsigned SnapshotAndReset(List<char>* output);
+
+  int unique_stacks() const { return static_cast<int>(stacks_.occupancy()); }
+  unsigned dropped_samples() const { return dropped_samples_; }
+
+ private:
+  struct FoldedStack {
+    int depth;
+    unsigned count;
+    // Outermost caller first.
+    CodeEntry** frames;
+  };
+
+  static uint32_t StackHash(CodeEntry** frames, int depth);
+  static bool StacksMatch(void* key1, void* key2);
+  static void AppendFrameName(CodeEntry* entry, List<char>* output);
+  void Clear();
+
+  const int max_unique_stacks_;
+  HashMap stacks_;
+  // Samples that did not fit because the table was full.
+  unsigned dropped_samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(FoldedStacksTable);
+};
+
+
 class CpuProfilesCollection {
  public:
   CpuProfilesCollection();
@@ -320,6 +362,9 @@ class CpuProfilesCollection {
   CpuProfile* GetProfile(int security_token_id, unsigned uid);
   bool IsLastProfile(const char* title);
   void RemoveProfile(CpuProfile* profile);
+  // Deletes all profiles, including those being collected, but keeps the
+  // code entries and the folded stacks.
+  void DeleteAllProfiles();
   bool HasDetachedProfiles() { return detached_profiles_.length() > 0; }
 
   CodeEntry* NewCodeEntry(Logger::LogEventsAndTags tag,
@@ -333,6 +378,16 @@ class CpuProfilesCollection {
   // Called from profile generator thread.
   void AddPathToCurrentProfiles(const Vector<CodeEntry*>& path);
 
+  // Continuous sampling into a FoldedStacksTable, independent of the
+  // titled profiles above.
+  bool StartFoldedStacks(int max_unique_stacks);
+  void StopFoldedStacks();
+  bool is_collecting_folded_stacks() const { return folded_stacks_ != NULL; }
+  bool HasCurrentProfiles() const { return !current_profiles_.is_empty(); }
+  // Called from VM thread. Returns the samples dropped since the previous
+  // snapshot.
+  unsigned SnapshotFoldedStacks(List<char>* output);
+
   // Limits the number of profiles that can be simultaneously collected.
   static const int kMaxSimultaneousProfiles = 100;
 
@@ -361,6 +416,7 @@ class CpuProfilesCollection {
 
   // Accessed by VM thread and profile generator thread.
   List<CpuProfile*> current_profiles_;
+  FoldedStacksTable* folded_stacks_;
   Semaphore* current_profiles_semaphore_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfilesCollection);
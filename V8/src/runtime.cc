@@ -659,26 +659,51 @@ static void ArrayBufferWeakCallback(v8::Isolate* external_isolate,
   HandleScope scope(isolate);
   Handle<Object> internal_object = Utils::OpenHandle(**object);
 
-  size_t allocated_length = NumberToSize(
-      isolate, JSArrayBuffer::cast(*internal_object)->byte_length());
-  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
-      -static_cast<intptr_t>(allocated_length));
-  if (data != NULL)
-    free(data);
+  // The backing store may have been transferred away since the handle was
+  // made weak, so it is looked up on the buffer rather than passed in.
+  Runtime::FreeArrayBuffer(isolate, JSArrayBuffer::cast(*internal_object));
   object->Dispose(external_isolate);
 }
 
 
+static void FreeArrayBufferBackingStore(void* data,
+                                        size_t byte_length,
+                                        void* parameter) {
+  free(data);
+}
+
+
+static void MakeArrayBufferWeak(Isolate* isolate,
+                                Handle<JSArrayBuffer> array_buffer,
+                                size_t allocated_length) {
+  v8::Isolate* external_isolate = reinterpret_cast<v8::Isolate*>(isolate);
+  v8::Persistent<v8::Value> weak_handle = v8::Persistent<v8::Value>::New(
+      external_isolate, v8::Utils::ToLocal(Handle<Object>::cast(array_buffer)));
+  weak_handle.MakeWeak(external_isolate,
+                       static_cast<void*>(NULL),
+                       ArrayBufferWeakCallback);
+  weak_handle.MarkIndependent(external_isolate);
+  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(allocated_length);
+}
+
+
 bool Runtime::SetupArrayBuffer(Isolate* isolate,
                                Handle<JSArrayBuffer> array_buffer,
                                void* data,
                                size_t allocated_length) {
   array_buffer->set_backing_store(data);
+  array_buffer->set_flag(0);
+  array_buffer->set_is_external(true);
+  array_buffer->set_release_info(NULL);
 
   Handle<Object> byte_length =
       isolate->factory()->NewNumberFromSize(allocated_length);
   CHECK(byte_length->IsSmi() || byte_length->IsHeapNumber());
   array_buffer->set_byte_length(*byte_length);
+
+  array_buffer->set_weak_first_view(isolate->heap()->undefined_value());
+  array_buffer->set_weak_next(isolate->heap()->array_buffers_list());
+  isolate->heap()->set_array_buffers_list(*array_buffer);
   return true;
 }
 
@@ -698,18 +723,91 @@ bool Runtime::SetupArrayBufferAllocatingData(
 
   if (!SetupArrayBuffer(isolate, array_buffer, data, allocated_length))
     return false;
+  array_buffer->set_is_external(false);
 
-  v8::Isolate* external_isolate = reinterpret_cast<v8::Isolate*>(isolate);
-  v8::Persistent<v8::Value> weak_handle = v8::Persistent<v8::Value>::New(
-      external_isolate, v8::Utils::ToLocal(Handle<Object>::cast(array_buffer)));
-  weak_handle.MakeWeak(external_isolate, data, ArrayBufferWeakCallback);
-  weak_handle.MarkIndependent(external_isolate);
-  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(allocated_length);
+  MakeArrayBufferWeak(isolate, array_buffer, allocated_length);
+  return true;
+}
+
+
+bool Runtime::SetupArrayBufferWithReleaseCallback(
+    Isolate* isolate,
+    Handle<JSArrayBuffer> array_buffer,
+    void* data,
+    size_t allocated_length,
+    v8::ArrayBuffer::ReleaseCallback callback,
+    void* parameter) {
+  ASSERT(callback != NULL);
+  if (!SetupArrayBuffer(isolate, array_buffer, data, allocated_length))
+    return false;
+  array_buffer->set_is_external(false);
+
+  ArrayBufferReleaseInfo* release_info = new ArrayBufferReleaseInfo;
+  release_info->callback = callback;
+  release_info->parameter = parameter;
+  array_buffer->set_release_info(release_info);
 
+  MakeArrayBufferWeak(isolate, array_buffer, allocated_length);
   return true;
 }
 
 
+void Runtime::FreeArrayBuffer(Isolate* isolate,
+                              JSArrayBuffer* phantom_array_buffer) {
+  if (phantom_array_buffer->is_external()) return;
+
+  size_t allocated_length = NumberToSize(
+      isolate, phantom_array_buffer->byte_length());
+  isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<intptr_t>(allocated_length));
+
+  void* data = phantom_array_buffer->backing_store();
+  ArrayBufferReleaseInfo* release_info =
+      reinterpret_cast<ArrayBufferReleaseInfo*>(
+          phantom_array_buffer->release_info());
+  if (release_info != NULL) {
+    release_info->callback(data, allocated_length, release_info->parameter);
+    delete release_info;
+  } else {
+    free(data);
+  }
+
+  phantom_array_buffer->set_is_external(true);
+  phantom_array_buffer->set_release_info(NULL);
+  phantom_array_buffer->set_backing_store(NULL);
+}
+
+
+void Runtime::TransferArrayBuffer(Isolate* isolate,
+                                  Handle<JSArrayBuffer> array_buffer,
+                                  ArrayBufferReleaseInfo* release_info) {
+  if (array_buffer->is_external()) {
+    release_info->callback = NULL;
+    release_info->parameter = NULL;
+  } else {
+    size_t allocated_length = NumberToSize(
+        isolate, array_buffer->byte_length());
+    isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<intptr_t>(allocated_length));
+
+    ArrayBufferReleaseInfo* own_release_info =
+        reinterpret_cast<ArrayBufferReleaseInfo*>(
+            array_buffer->release_info());
+    if (own_release_info != NULL) {
+      *release_info = *own_release_info;
+      delete own_release_info;
+    } else {
+      release_info->callback = FreeArrayBufferBackingStore;
+      release_info->parameter = NULL;
+    }
+    // The weak handle of the buffer stays around but has nothing to free.
+    array_buffer->set_is_external(true);
+    array_buffer->set_release_info(NULL);
+  }
+  array_buffer->Neuter();
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_ArrayBufferInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 2);
@@ -841,6 +939,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_TypedArrayInitialize) {
   holder->set_buffer(*buffer);
   holder->set_byte_offset(*byte_offset_object);
   holder->set_byte_length(*byte_length_object);
+  holder->set_weak_next(buffer->weak_first_view());
+  buffer->set_weak_first_view(*holder);
 
   size_t byte_offset = NumberToSize(isolate, *byte_offset_object);
   size_t byte_length = NumberToSize(isolate, *byte_length_object);
@@ -2712,6 +2812,10 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringCharCodeAt) {
   // Flatten the string.  If someone wants to get a char at an index
   // in a cons string, it is likely that more indices will be
   // accessed.
+  if (!subject->IsFlat()) {
+    isolate->counters()->string_flatten_charcodeat()->Increment(
+        subject->length());
+  }
   Object* flat;
   { MaybeObject* maybe_flat = subject->TryFlatten();
     if (!maybe_flat->ToObject(&flat)) return maybe_flat;
@@ -3766,7 +3870,10 @@ int Runtime::StringMatch(Isolate* isolate,
   int subject_length = sub->length();
   if (start_index + pattern_length > subject_length) return -1;
 
-  if (!sub->IsFlat()) FlattenString(sub);
+  if (!sub->IsFlat()) {
+    isolate->counters()->string_flatten_indexof()->Increment(sub->length());
+    FlattenString(sub);
+  }
   if (!pat->IsFlat()) FlattenString(pat);
 
   AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
@@ -3876,7 +3983,10 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringLastIndexOf) {
     return Smi::FromInt(start_index);
   }
 
-  if (!sub->IsFlat()) FlattenString(sub);
+  if (!sub->IsFlat()) {
+    isolate->counters()->string_flatten_indexof()->Increment(sub->length());
+    FlattenString(sub);
+  }
   if (!pat->IsFlat()) FlattenString(pat);
 
   int position = -1;
@@ -7576,7 +7686,7 @@ static SmartArrayPointer<Handle<Object> > GetCallerArguments(
       param_data[prefix_argc + i] = val;
     }
 
-    args_slots.Dispose();
+    SlotRef::DisposeSlotMapping(args_slots);
 
     return param_data;
   } else {
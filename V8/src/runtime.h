@@ -750,6 +750,14 @@ class Runtime : public AllStatic {
       Handle<Object> object,
       Handle<Object> key);
 
+  // Describes how a backing store handed over by the embedder is released
+  // once V8 no longer needs it.
+  struct ArrayBufferReleaseInfo {
+    v8::ArrayBuffer::ReleaseCallback callback;
+    void* parameter;
+  };
+
+  // Sets up an array buffer over memory that V8 never frees.
   static bool SetupArrayBuffer(Isolate* isolate,
                                Handle<JSArrayBuffer> array_buffer,
                                void* data,
@@ -760,6 +768,28 @@ class Runtime : public AllStatic {
       Handle<JSArrayBuffer> array_buffer,
       size_t allocated_length);
 
+  // Sets up an array buffer that takes ownership of |data| and calls
+  // |callback| to release it when the buffer is garbage-collected.
+  static bool SetupArrayBufferWithReleaseCallback(
+      Isolate* isolate,
+      Handle<JSArrayBuffer> array_buffer,
+      void* data,
+      size_t allocated_length,
+      v8::ArrayBuffer::ReleaseCallback callback,
+      void* parameter);
+
+  // Releases the backing store of an array buffer that is about to die,
+  // unless it is external.
+  static void FreeArrayBuffer(Isolate* isolate,
+                              JSArrayBuffer* phantom_array_buffer);
+
+  // Hands ownership of the backing store over to the caller and neuters the
+  // array buffer and all its views. The caller releases the memory through
+  // |release_info|; a NULL callback means the memory was external.
+  static void TransferArrayBuffer(Isolate* isolate,
+                                  Handle<JSArrayBuffer> array_buffer,
+                                  ArrayBufferReleaseInfo* release_info);
+
   // Helper functions used stubs.
   static void PerformGC(Object* result);
 
@@ -455,6 +455,7 @@ class SamplerThread : public Thread {
           Sampler* sampler = active_samplers_.at(i);
           if (!sampler->isolate()->IsInitialized()) continue;
           if (!sampler->IsProfiling()) continue;
+          if (!sampler->ShouldSampleOnThisTick()) continue;
           SampleContext(sampler);
         }
       }
@@ -673,6 +674,8 @@ Sampler::Sampler(Isolate* isolate, int interval)
       interval_(interval),
       profiling_(false),
       active_(false),
+      sampling_stride_(1),
+      ticks_since_sample_(0),
       samples_taken_(0) {
   data_ = new PlatformData;
 }
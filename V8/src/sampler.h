@@ -100,6 +100,21 @@ class Sampler {
   // Whether the sampler is running (that is, consumes resources).
   bool IsActive() const { return NoBarrier_Load(&active_); }
 
+  // Only every stride-th tick of the sampler thread takes a sample, which
+  // lets continuous profiling run below the base sampling rate.
+  void SetSamplingStride(int stride) {
+    ASSERT(stride > 0);
+    NoBarrier_Store(&sampling_stride_, stride);
+  }
+  // Called from the sampler thread on every tick.
+  bool ShouldSampleOnThisTick() {
+    if (++ticks_since_sample_ < NoBarrier_Load(&sampling_stride_)) {
+      return false;
+    }
+    ticks_since_sample_ = 0;
+    return true;
+  }
+
   // Used in tests to make sure that stack sampling is performed.
   int samples_taken() const { return samples_taken_; }
   void ResetSamplesTaken() { samples_taken_ = 0; }
@@ -114,6 +129,8 @@ class Sampler {
   const int interval_;
   Atomic32 profiling_;
   Atomic32 active_;
+  Atomic32 sampling_stride_;
+  int ticks_since_sample_;  // Accessed only from the sampler thread.
   PlatformData* data_;  // Platform specific data.
   int samples_taken_;  // Counts stack samples taken.
   DISALLOW_IMPLICIT_CONSTRUCTORS(Sampler);
@@ -934,6 +934,7 @@ PagedSpace::PagedSpace(Heap* heap,
   max_capacity_ = (RoundDown(max_capacity, Page::kPageSize) / Page::kPageSize)
       * AreaSize();
   accounting_stats_.Clear();
+  ResetPageOccupancy();
 
   allocation_info_.top = NULL;
   allocation_info_.limit = NULL;
@@ -1071,6 +1072,35 @@ int PagedSpace::CountTotalPages() {
 }
 
 
+void PagedSpace::ResetPageOccupancy() {
+  for (int i = 0; i < kOccupancyBuckets; i++) pages_with_occupancy_[i] = 0;
+  pages_with_recorded_occupancy_ = 0;
+}
+
+
+void PagedSpace::RecordPageOccupancy(Page* p) {
+  ASSERT(p->owner() == this);
+  int bucket = static_cast<int>(
+      static_cast<int64_t>(p->LiveBytes()) * kOccupancyBuckets /
+      p->area_size());
+  if (bucket >= kOccupancyBuckets) bucket = kOccupancyBuckets - 1;
+  pages_with_occupancy_[bucket]++;
+  pages_with_recorded_occupancy_++;
+}
+
+
+void PagedSpace::FinishPageOccupancy() {
+  // Pages added during evacuation have no live byte count.  The evacuator
+  // fills them front to back with live objects, so they count as full.
+  int added_pages = CountTotalPages() - pages_with_recorded_occupancy_;
+  ASSERT(added_pages >= 0);
+  if (added_pages > 0) {
+    pages_with_occupancy_[kOccupancyBuckets - 1] += added_pages;
+    pages_with_recorded_occupancy_ += added_pages;
+  }
+}
+
+
 void PagedSpace::ObtainFreeListStatistics(Page* page, SizeStats* sizes) {
   sizes->huge_size_ = page->available_in_huge_free_list();
   sizes->small_size_ = page->available_in_small_free_list();
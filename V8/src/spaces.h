@@ -1815,6 +1815,27 @@ class PagedSpace : public Space {
   // Returns the number of total pages in this space.
   int CountTotalPages();
 
+  // Pages are bucketed by the fraction of their area that was found live:
+  // bucket i holds the pages that were between i / kOccupancyBuckets and
+  // (i + 1) / kOccupancyBuckets full.
+  static const int kOccupancyBuckets = 4;
+
+  // The page occupancy histogram is rebuilt by every full GC from the live
+  // byte counts of the pages that stay in the space: ResetPageOccupancy()
+  // starts it, RecordPageOccupancy() has to be called for each such page
+  // after marking and before sweeping resets its count, and
+  // FinishPageOccupancy() accounts for the pages the space grew by while
+  // live objects were evacuated into it.
+  void ResetPageOccupancy();
+  void RecordPageOccupancy(Page* p);
+  void FinishPageOccupancy();
+
+  // Number of pages in the given occupancy bucket as of the last full GC.
+  int PagesWithOccupancy(int bucket) {
+    ASSERT(bucket >= 0 && bucket < kOccupancyBuckets);
+    return pages_with_occupancy_[bucket];
+  }
+
   // Return size of allocatable area on a page in this space.
   inline int AreaSize() {
     return area_size_;
@@ -1859,6 +1880,12 @@ class PagedSpace : public Space {
   // done conservatively.
   intptr_t unswept_free_bytes_;
 
+  // Page occupancy histogram recorded by the last full GC.
+  int pages_with_occupancy_[kOccupancyBuckets];
+
+  // Number of pages recorded in the histogram so far.
+  int pages_with_recorded_occupancy_;
+
   // Expands the space by allocating a fixed number of pages. Returns false if
   // it cannot allocate requested number of pages from OS, or if the hard heap
   // size limit has been hit.
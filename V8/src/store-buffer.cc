@@ -142,6 +142,22 @@ void StoreBuffer::Uniq() {
 }
 
 
+void StoreBuffer::Shrink() {
+  ASSERT(!during_gc_);
+  intptr_t initial_length =
+      static_cast<intptr_t>(OS::CommitPageSize() / kPointerSize);
+  // EnsureSpace doubles the committed length, so halve it to stay on the
+  // same sizes.
+  while (old_limit_ - old_start_ > initial_length &&
+         old_top_ - old_start_ <= (old_limit_ - old_start_) / 2) {
+    size_t shrink = (old_limit_ - old_start_) / 2;
+    old_limit_ -= shrink;
+    CHECK(old_virtual_memory_->Uncommit(reinterpret_cast<void*>(old_limit_),
+                                        shrink * kPointerSize));
+  }
+}
+
+
 void StoreBuffer::EnsureSpace(intptr_t space_needed) {
   while (old_limit_ - old_top_ < space_needed &&
          old_limit_ < old_reserved_limit_) {
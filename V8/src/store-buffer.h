@@ -112,6 +112,10 @@ class StoreBuffer {
   void SortUniq();
 
   void EnsureSpace(intptr_t space_needed);
+
+  // Uncommits the part of the old buffer that is not needed to hold its
+  // current entries.  The buffer grows again on demand.
+  void Shrink();
   void Verify();
 
   bool PrepareForIteration();
@@ -140,7 +140,9 @@ namespace internal {
   SC(pc_to_code_cached, V8.PcToCodeCached)                            \
   /* The store-buffer implementation of the write barrier. */         \
   SC(store_buffer_compactions, V8.StoreBufferCompactions)             \
-  SC(store_buffer_overflows, V8.StoreBufferOverflows)
+  SC(store_buffer_overflows, V8.StoreBufferOverflows)                 \
+  /* Bounds checks hoisted out of counting loops. */                  \
+  SC(bounds_checks_hoisted, V8.BoundsChecksHoisted)
 
 
 #define STATS_COUNTER_LIST_2(SC)                                      \
@@ -251,6 +253,13 @@ namespace internal {
   SC(string_add_make_two_char, V8.StringAddMakeTwoChar)               \
   SC(string_compare_native, V8.StringCompareNative)                   \
   SC(string_compare_runtime, V8.StringCompareRuntime)                 \
+  SC(string_flatten_chars, V8.StringFlattenChars)                     \
+  SC(string_flatten_charcodeat, V8.StringFlattenCharCodeAt)           \
+  SC(string_flatten_regexp, V8.StringFlattenRegExp)                   \
+  SC(string_flatten_indexof, V8.StringFlattenIndexOf)                 \
+  SC(string_flatten_compare, V8.StringFlattenCompare)                 \
+  SC(string_builder_allocations, V8.StringBuilderAllocations)         \
+  SC(string_builder_appends, V8.StringBuilderAppends)                 \
   SC(regexp_entry_runtime, V8.RegExpEntryRuntime)                     \
   SC(regexp_entry_native, V8.RegExpEntryNative)                       \
   SC(number_to_string_native, V8.NumberToStringNative)                \
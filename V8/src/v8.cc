@@ -196,6 +196,15 @@ bool V8::IdleNotification(int hint) {
 }
 
 
+bool V8::IdleNotificationInMs(int idle_time_in_ms) {
+  // Returning true tells the caller that there is no need to call
+  // IdleNotificationInMs again.
+  if (!FLAG_use_idle_notification) return true;
+
+  return HEAP->IdleNotificationInMs(idle_time_in_ms);
+}
+
+
 void V8::AddCallCompletedCallback(CallCompletedCallback callback) {
   if (call_completed_callbacks_ == NULL) {  // Lazy init.
     call_completed_callbacks_ = new List<CallCompletedCallback>();
@@ -115,6 +115,7 @@ class V8 : public AllStatic {
 
   // Idle notification directly from the API.
   static bool IdleNotification(int hint);
+  static bool IdleNotificationInMs(int idle_time_in_ms);
 
   static void AddCallCompletedCallback(CallCompletedCallback callback);
   static void RemoveCallCompletedCallback(CallCompletedCallback callback);
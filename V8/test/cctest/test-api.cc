@@ -2323,6 +2323,98 @@ THREADED_TEST(ArrayBuffer) {
 }
 
 
+static int array_buffer_release_count = 0;
+
+
+static void ReleaseArrayBufferData(void* data,
+                                   size_t byte_length,
+                                   void* parameter) {
+  CHECK_EQ(parameter, data);
+  delete[] static_cast<uint8_t*>(data);
+  array_buffer_release_count++;
+}
+
+
+static void ArrayBufferCollected(v8::Isolate* isolate,
+                                 Persistent<v8::ArrayBuffer>* handle,
+                                 int* collected_count) {
+  (*collected_count)++;
+  handle->Dispose(isolate);
+}
+
+
+TEST(ArrayBufferTransfer) {
+  i::FLAG_harmony_array_buffer = true;
+  i::FLAG_harmony_typed_arrays = true;
+
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  array_buffer_release_count = 0;
+
+  uint8_t* my_data = new uint8_t[100];
+  memset(my_data, 0, 100);
+  v8::ArrayBuffer::Contents contents;
+  Persistent<v8::ArrayBuffer> weak_ab;
+  int collected_count = 0;
+  {
+    // The buffer is only referenced from this scope, so that closing it
+    // leaves the buffer to the collector below.
+    v8::HandleScope inner_scope(isolate);
+    Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(
+        my_data, 100, ReleaseArrayBufferData, my_data);
+    CHECK(!ab->IsExternal());
+    weak_ab = Persistent<v8::ArrayBuffer>::New(isolate, ab);
+    weak_ab.MakeWeak(isolate, &collected_count, &ArrayBufferCollected);
+    env->Global()->Set(v8_str("ab"), ab);
+    v8::Handle<v8::Value> result =
+        CompileRun("var u8 = new Uint8Array(ab);"
+                   "var u16 = new Uint16Array(ab, 2, 4);"
+                   "u8[0] = 0xAA; u8[1] = 0xBB; u8.length + u16.length");
+    CHECK_EQ(104, result->Int32Value());
+
+    // Transferring hands out the same memory and neuters all views.
+    contents = ab->Transfer();
+    CHECK_EQ(my_data, contents.Data());
+    CHECK_EQ(100, static_cast<int>(contents.ByteLength()));
+    CHECK_EQ(0, static_cast<int>(ab->ByteLength()));
+    CHECK(ab->Data() == NULL);
+    result = CompileRun("ab.byteLength + u8.length + u8.byteLength +"
+                        "u16.length + u16.byteOffset");
+    CHECK_EQ(0, result->Int32Value());
+    CHECK(CompileRun("u8[0]")->IsUndefined());
+    CompileRun("ab = null; u8 = null; u16 = null;");
+  }
+
+  // Collecting the neutered buffer must not release the transferred memory.
+  HEAP->CollectAllAvailableGarbage();
+  CHECK_EQ(1, collected_count);
+  CHECK_EQ(0, array_buffer_release_count);
+
+  {
+    v8::HandleScope inner_scope(isolate);
+    Local<v8::ArrayBuffer> ab2 = v8::ArrayBuffer::New(contents);
+    CHECK_EQ(my_data, ab2->Data());
+    Local<v8::Uint8Array> u8 = v8::Uint8Array::New(ab2, 0, 100);
+    uint8_t* data = static_cast<uint8_t*>(u8->BaseAddress());
+    CHECK_EQ(0xAA, data[0]);
+    CHECK_EQ(0xBB, data[1]);
+  }
+
+  // The receiving buffer owns the memory now.
+  HEAP->CollectAllAvailableGarbage();
+  CHECK_EQ(1, array_buffer_release_count);
+
+  // Transferring memory that V8 allocated hands out a release callback.
+  Local<v8::ArrayBuffer> ab3 = v8::ArrayBuffer::New(16);
+  CHECK(!ab3->IsExternal());
+  v8::ArrayBuffer::Contents contents3 = ab3->Transfer();
+  CHECK(contents3.Data() != NULL);
+  contents3.Release();
+  CHECK(contents3.Data() == NULL);
+}
+
+
 
 
 
@@ -15826,6 +15918,43 @@ TEST(IdleNotificationWithLargeHint) {
 }
 
 
+// Test that frame-sized idle deadlines eventually collect garbage.
+TEST(IdleNotificationInMs) {
+  const intptr_t MB = 1024 * 1024;
+  const int kFrameIdleTimeInMs = 16;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  intptr_t initial_size = HEAP->SizeOfObjects();
+  CreateGarbageInOldSpace();
+  intptr_t size_with_garbage = HEAP->SizeOfObjects();
+  CHECK_GT(size_with_garbage, initial_size + MB);
+  bool finished = false;
+  for (int i = 0; i < 1000 && !finished; i++) {
+    finished = v8::V8::IdleNotificationInMs(kFrameIdleTimeInMs);
+  }
+  intptr_t final_size = HEAP->SizeOfObjects();
+  CHECK(finished);
+  CHECK_LT(final_size, initial_size + 1);
+}
+
+
+// Test that after context disposal a full GC is only done if it fits into
+// the idle time, which is in milliseconds rather than a unitless hint.
+TEST(IdleNotificationInMsAfterContextDisposal) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CreateGarbageInOldSpace();
+  int ms_count = static_cast<int>(HEAP->ms_count());
+  v8::V8::ContextDisposedNotification();
+  // Collecting at least 8MB of garbage takes longer than 1ms.
+  v8::V8::IdleNotificationInMs(1);
+  CHECK_EQ(ms_count, static_cast<int>(HEAP->ms_count()));
+  v8::V8::ContextDisposedNotification();
+  v8::V8::IdleNotificationInMs(10000);
+  CHECK_GT(static_cast<int>(HEAP->ms_count()), ms_count);
+}
+
+
 TEST(Regress2107) {
   const intptr_t MB = 1024 * 1024;
   const int kShortIdlePauseInMs = 100;
@@ -15949,6 +16078,46 @@ THREADED_TEST(GetHeapStatistics) {
 }
 
 
+TEST(GetHeapSpaceStatistics) {
+  LocalContext c1;
+  v8::Isolate* isolate = c1->GetIsolate();
+  v8::HandleScope scope(isolate);
+  HEAP->CollectAllGarbage(i::Heap::kNoGCFlags);
+  v8::HeapStatistics heap_statistics;
+  isolate->GetHeapStatistics(&heap_statistics);
+  size_t total_size = 0;
+  for (size_t i = 0; i < isolate->NumberOfHeapSpaces(); i++) {
+    v8::HeapSpaceStatistics space_statistics;
+    CHECK(isolate->GetHeapSpaceStatistics(&space_statistics, i));
+    CHECK_NE(NULL, space_statistics.space_name());
+    size_t bucketed_pages = 0;
+    for (int j = 0; j < v8::HeapSpaceStatistics::kOccupancyBuckets; j++) {
+      bucketed_pages += space_statistics.pages_with_occupancy(j);
+    }
+    if (i != static_cast<size_t>(i::NEW_SPACE)) {
+      CHECK_EQ(static_cast<int>(space_statistics.number_of_pages()),
+               static_cast<int>(bucketed_pages));
+    }
+    total_size += space_statistics.space_size();
+  }
+  CHECK_EQ(static_cast<int>(heap_statistics.total_heap_size()),
+           static_cast<int>(total_size));
+  v8::HeapSpaceStatistics space_statistics;
+  CHECK(!isolate->GetHeapSpaceStatistics(&space_statistics,
+                                         isolate->NumberOfHeapSpaces()));
+
+  v8::HeapObjectStatistics object_statistics;
+  bool tracked = isolate->GetHeapObjectStatisticsAtLastGC(
+      &object_statistics, i::JS_OBJECT_TYPE);
+  CHECK_EQ(i::FLAG_track_gc_object_stats, tracked);
+  if (tracked) {
+    CHECK_EQ(0, strcmp("JS_OBJECT_TYPE", object_statistics.object_type()));
+  }
+  CHECK(!isolate->GetHeapObjectStatisticsAtLastGC(
+      &object_statistics, isolate->NumberOfTrackedHeapObjectTypes()));
+}
+
+
 class VisitorImpl : public v8::ExternalResourceVisitor {
  public:
   explicit VisitorImpl(TestResource** resource) {
@@ -376,6 +376,71 @@ TEST(OptimizedCodeSharing) {
 }
 
 
+
+static int bounds_checks_hoisted_counter = 0;
+
+
+static int* LookupBoundsChecksHoistedCounter(const char* name) {
+  if (strcmp(name, "c:V8.BoundsChecksHoisted") == 0) {
+    return &bounds_checks_hoisted_counter;
+  }
+  return NULL;
+}
+
+
+// Test that bounds checks executed in every iteration of a counting loop are
+// hoisted into the pre-header, and that conditionally executed ones are not.
+TEST(BoundsChecksHoisting) {
+  FLAG_allow_natives_syntax = true;
+  FLAG_array_bounds_checks_hoisting = true;
+  v8::V8::SetCounterFunction(LookupBoundsChecksHoistedCounter);
+  CcTest::InitializeVM();
+  if (!V8::UseCrankshaft()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  int initial_hoisted = bounds_checks_hoisted_counter;
+  CompileRun("function sum(a) {"
+             "  var s = 0;"
+             "  for (var i = 0; i < a.length; i++) s += a[i];"
+             "  return s;"
+             "}"
+             "var a = [1, 2, 3, 4];"
+             "sum(a);"
+             "sum(a);"
+             "%OptimizeFunctionOnNextCall(sum);"
+             "sum(a);");
+  CHECK_GT(bounds_checks_hoisted_counter, initial_hoisted);
+
+  initial_hoisted = bounds_checks_hoisted_counter;
+  CompileRun("function sumEven(a) {"
+             "  var s = 0;"
+             "  for (var i = 0; i < a.length; i++) {"
+             "    if (i % 2 == 0) s += a[i];"
+             "  }"
+             "  return s;"
+             "}"
+             "sumEven(a);"
+             "sumEven(a);"
+             "%OptimizeFunctionOnNextCall(sumEven);"
+             "sumEven(a);");
+  CHECK_EQ(initial_hoisted, bounds_checks_hoisted_counter);
+
+  // Loops with exits other than the header test are left alone.
+  CompileRun("function sumWithBreak(a, n) {"
+             "  var s = 0;"
+             "  for (var i = 0; i < n; i++) {"
+             "    if (i >= a.length) break;"
+             "    s += a[i];"
+             "  }"
+             "  return s;"
+             "}"
+             "sumWithBreak(a, 100);"
+             "sumWithBreak(a, 100);"
+             "%OptimizeFunctionOnNextCall(sumWithBreak);"
+             "sumWithBreak(a, 100);");
+  CHECK_EQ(initial_hoisted, bounds_checks_hoisted_counter);
+}
+
 #ifdef ENABLE_DISASSEMBLER
 static Handle<JSFunction> GetJSFunction(v8::Handle<v8::Object> obj,
                                  const char* property_name) {
@@ -214,6 +214,53 @@ TEST(TickEvents) {
 }
 
 
+TEST(FoldedStacks) {
+  TestSetup test_setup;
+  CpuProfilesCollection profiles;
+  CHECK(profiles.StartFoldedStacks(2));
+  CHECK(!profiles.StartFoldedStacks(2));
+  ProfileGenerator generator(&profiles);
+  ProfilerEventsProcessor processor(&generator, &profiles);
+  processor.Start();
+
+  processor.CodeCreateEvent(i::Logger::BUILTIN_TAG,
+                            "bbb",
+                            ToAddress(0x1200),
+                            0x80);
+  processor.CodeCreateEvent(i::Logger::STUB_TAG, 5, ToAddress(0x1300), 0x10);
+  processor.CodeCreateEvent(i::Logger::BUILTIN_TAG,
+                            "ddd",
+                            ToAddress(0x1400),
+                            0x80);
+  EnqueueTickSampleEvent(&processor, ToAddress(0x1210));
+  EnqueueTickSampleEvent(&processor, ToAddress(0x1220));
+  EnqueueTickSampleEvent(&processor, ToAddress(0x1305), ToAddress(0x1220));
+  // A third unique stack doesn't fit into the table.
+  EnqueueTickSampleEvent(&processor,
+                         ToAddress(0x1404),
+                         ToAddress(0x1305),
+                         ToAddress(0x1230));
+
+  processor.Stop();
+  processor.Join();
+
+  i::List<char> folded;
+  CHECK_EQ(1, static_cast<int>(profiles.SnapshotFoldedStacks(&folded)));
+  folded.Add('\0');
+  const char* text = &folded[0];
+  CHECK_NE(NULL, strstr(text, "bbb 2\n"));
+  CHECK_NE(NULL, strstr(text, "bbb;5 1\n"));
+  CHECK_EQ(NULL, strstr(text, "ddd"));
+
+  // Taking a snapshot resets the counts.
+  i::List<char> empty;
+  CHECK_EQ(0, static_cast<int>(profiles.SnapshotFoldedStacks(&empty)));
+  CHECK_EQ(0, empty.length());
+  profiles.StopFoldedStacks();
+  CHECK(!profiles.is_collecting_folded_stacks());
+}
+
+
 // http://crbug/51594
 // This test must not crash.
 TEST(CrashIfStoppingLastNonExistentProfile) {
@@ -294,6 +341,23 @@ TEST(DeleteAllCpuProfiles) {
   CHECK_EQ(0, profiler->GetProfilesCount());
   profiler->DeleteAllProfiles();
   CHECK_EQ(0, profiler->GetProfilesCount());
+
+  // Continuous sampling keeps running when all profiles are deleted.
+  profiler->StartContinuousSampling(100, 16);
+  profiler->StartProfiling("1");
+  profiler->StopProfiling("1");
+  profiler->StartProfiling("2");
+  CHECK_EQ(1, profiler->GetProfilesCount());
+  profiler->DeleteAllProfiles();
+  CHECK_EQ(0, profiler->GetProfilesCount());
+  CHECK(profiler->is_profiling());
+  profiler->StartProfiling("3");
+  profiler->StopProfiling("3");
+  CHECK_EQ(1, profiler->GetProfilesCount());
+  profiler->StopContinuousSampling();
+  CHECK(!profiler->is_profiling());
+  profiler->DeleteAllProfiles();
+  CHECK_EQ(0, profiler->GetProfilesCount());
 }
 
 
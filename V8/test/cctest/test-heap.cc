@@ -3103,3 +3103,37 @@ TEST(DeferredHandles) {
   isolate->handle_scope_implementer()->Iterate(&visitor);
   deferred.Detach();
 }
+
+
+TEST(ReduceMemoryFootprint) {
+  i::FLAG_incremental_marking = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+
+  // Fill several old space pages and keep only every eighth array alive,
+  // leaving the pages sparse.
+  static const int kArrayLength = 1000;
+  static const int kNumberOfArrays = 1024;
+  Handle<FixedArray> survivors =
+      factory->NewFixedArray(kNumberOfArrays / 8, TENURED);
+  for (int i = 0; i < kNumberOfArrays; i++) {
+    HandleScope inner_scope(isolate);
+    Handle<FixedArray> array = factory->NewFixedArray(kArrayLength, TENURED);
+    if (i % 8 == 0) survivors->set(i / 8, *array);
+  }
+  heap->new_space()->Grow();
+
+  heap->ReduceMemoryFootprint("test");
+  CHECK_EQ(heap->new_space()->InitialCapacity(),
+           static_cast<int>(heap->new_space()->Capacity()));
+
+  // The next full GC records how full the remaining pages are.  Apart from
+  // the first page and the last page the survivors were compacted into, no
+  // page should be sparse.
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_LE(heap->old_pointer_space()->PagesWithOccupancy(0), 2);
+  CHECK(survivors->get(kNumberOfArrays / 8 - 1)->IsFixedArray());
+}
@@ -1082,6 +1082,102 @@ TEST(SliceFromCons) {
 }
 
 
+TEST(StringBuilderFlatten) {
+  FLAG_string_slices = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* chunk = "0123456789abcdef";
+  const int kChunkLength = StrLength(chunk);
+  Handle<String> piece = FACTORY->NewStringFromAscii(CStrVector(chunk));
+
+  // Append and flatten repeatedly, the way a loop doing s += x followed by
+  // s.charCodeAt(i) does.
+  Handle<String> string = piece;
+  String* store = NULL;
+  int in_place_appends = 0;
+  for (int i = 1; i < 64; i++) {
+    string = FACTORY->NewConsString(string, piece);
+    FlattenString(string);
+    CHECK(string->IsFlat());
+    CHECK_EQ((i + 1) * kChunkLength, string->length());
+    if (string->IsSlicedString()) {
+      SlicedString* slice = SlicedString::cast(*string);
+      CHECK_EQ(0, slice->offset());
+      CHECK(slice->parent()->length() >= string->length());
+      if (slice->parent() == store) in_place_appends++;
+      store = slice->parent();
+    }
+  }
+  CHECK(store != NULL);
+  CHECK_GT(in_place_appends, 0);
+  for (int i = 0; i < string->length(); i++) {
+    CHECK_EQ(chunk[i % kChunkLength], string->Get(i));
+  }
+
+  // Appending to an older version of the string must not clobber the
+  // characters that a newer version has already appended.
+  Handle<String> x = FACTORY->NewStringFromAscii(CStrVector("x"));
+  Handle<String> y = FACTORY->NewStringFromAscii(CStrVector("y"));
+  Handle<String> with_x = FACTORY->NewConsString(string, x);
+  FlattenString(with_x);
+  Handle<String> with_y = FACTORY->NewConsString(string, y);
+  FlattenString(with_y);
+  CHECK_EQ('x', with_x->Get(with_x->length() - 1));
+  CHECK_EQ('y', with_y->Get(with_y->length() - 1));
+  CHECK_EQ(chunk[0], with_y->Get(0));
+}
+
+
+// Returns the number of characters the backing store of a flat string has
+// room for.
+static int FlatStoreLength(Handle<String> string) {
+  String* flat = *string;
+  if (flat->IsConsString()) flat = ConsString::cast(flat)->first();
+  if (flat->IsSlicedString()) flat = SlicedString::cast(flat)->parent();
+  return flat->length();
+}
+
+
+TEST(StringBuilderFlattenOnceIsExact) {
+  FLAG_string_slices = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  const int kPartLength = StringBuilderCache::kMinLength;
+  Vector<char> chars = Vector<char>::New(kPartLength);
+  for (int i = 0; i < kPartLength; i++) chars[i] = 'a' + i % 26;
+  Handle<String> part =
+      FACTORY->NewStringFromAscii(Vector<const char>(chars.start(),
+                                                     kPartLength));
+  chars.Dispose();
+
+  // "a + b + c" flattened once gets no room to grow.
+  Handle<String> string = FACTORY->NewConsString(
+      FACTORY->NewConsString(part, part), part);
+  FlattenString(string);
+  CHECK_EQ(3 * kPartLength, string->length());
+  CHECK_EQ(string->length(), FlatStoreLength(string));
+
+  // Only appending to it again gets it a store with room to grow.
+  Handle<String> appended = FACTORY->NewConsString(string, part);
+  FlattenString(appended);
+  CHECK_GT(FlatStoreLength(appended), appended->length());
+
+  // A substring from the start of that store is not a builder, so
+  // concatenations with it are flattened into exactly sized strings.
+  Handle<String> substring =
+      FACTORY->NewSubString(appended, 0, 2 * kPartLength);
+  CHECK(substring->IsSlicedString());
+  Handle<String> concatenated = FACTORY->NewConsString(
+      FACTORY->NewConsString(substring, part), part);
+  FlattenString(concatenated);
+  CHECK_EQ(4 * kPartLength, concatenated->length());
+  CHECK_EQ(concatenated->length(), FlatStoreLength(concatenated));
+  for (int i = 0; i < concatenated->length(); i++) {
+    CHECK_EQ('a' + i % kPartLength % 26, concatenated->Get(i));
+  }
+}
+
+
 class AsciiVectorResource : public v8::String::ExternalAsciiStringResource {
  public:
   explicit AsciiVectorResource(i::Vector<const char> vector)
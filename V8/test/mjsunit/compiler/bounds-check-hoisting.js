@@ -0,0 +1,110 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --array-bounds-checks-hoisting
+
+// Test hoisting of bounds checks out of counting loops.
+(function testFastElements() {
+  function sum(a) {
+    var s = 0;
+    for (var i = 0; i < a.length; i++) s += a[i];
+    return s;
+  }
+  var a = [1, 2, 3, 4];
+  assertEquals(10, sum(a));
+  assertEquals(10, sum(a));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(a));
+  assertEquals(0, sum([]));
+})();
+
+
+(function testTypedArray() {
+  function scale(a, n, f) {
+    for (var i = 0; i < n; i++) a[i] = a[i] * f;
+  }
+  var a = new Uint8Array(8);
+  for (var i = 0; i < a.length; i++) a[i] = i;
+  scale(a, 8, 2);
+  scale(a, 8, 1);
+  %OptimizeFunctionOnNextCall(scale);
+  scale(a, 8, 1);
+  assertEquals(14, a[7]);
+  // An empty loop must not fail the hoisted checks.
+  scale(a, 0, 2);
+  assertEquals(14, a[7]);
+  // Out of bounds reads deoptimize before the loop.
+  scale(a, 9, 1);
+  assertEquals(14, a[7]);
+})();
+
+
+(function testOffset() {
+  function diff(a, n) {
+    var s = 0;
+    for (var i = 1; i < n; i++) s += a[i] - a[i - 1];
+    return s;
+  }
+  var a = [1, 3, 6, 10];
+  assertEquals(9, diff(a, 4));
+  assertEquals(9, diff(a, 4));
+  %OptimizeFunctionOnNextCall(diff);
+  assertEquals(9, diff(a, 4));
+  assertEquals(0, diff(a, 1));
+  assertTrue(isNaN(diff(a, 5)));
+})();
+
+
+(function testEarlyExit() {
+  // The loop limit is only an upper bound here. Hoisting the check would
+  // reject it before the loop and deoptimize on every call.
+  function sumWithBreak(a, n) {
+    var s = 0;
+    for (var i = 0; i < n; i++) {
+      if (i >= a.length) break;
+      s += a[i];
+    }
+    return s;
+  }
+  function sumWithReturn(a, n) {
+    var s = 0;
+    for (var i = 0; i < n; i++) {
+      if (i >= a.length) return s;
+      s += a[i];
+    }
+    return s;
+  }
+  var a = [1, 2, 3, 4];
+  [sumWithBreak, sumWithReturn].forEach(function(f) {
+    assertEquals(10, f(a, 100));
+    assertEquals(10, f(a, 100));
+    %OptimizeFunctionOnNextCall(f);
+    assertEquals(10, f(a, 100));
+    assertEquals(10, f(a, 100));
+    assertTrue(2 != %GetOptimizationStatus(f));
+  });
+})();
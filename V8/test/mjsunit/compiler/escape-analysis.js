@@ -0,0 +1,117 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --use-escape-analysis
+
+// Test scalar replacement of non-escaping allocations.
+(function testInlinedConstructor() {
+  function Point(x, y) {
+    this.x = x;
+    this.y = y;
+  }
+  function norm(x, y) {
+    var p = new Point(x, y);
+    return p.x * p.x + p.y * p.y;
+  }
+  assertEquals(25, norm(3, 4));
+  assertEquals(25, norm(3, 4));
+  %OptimizeFunctionOnNextCall(norm);
+  assertEquals(25, norm(3, 4));
+  assertEquals(0, norm(0, 0));
+})();
+
+
+// Test scalar replacement of object literals.
+(function testLiteral() {
+  function sum(a, b) {
+    var o = { a: a, b: b };
+    return o.a + o.b;
+  }
+  assertEquals(3, sum(1, 2));
+  assertEquals(3, sum(1, 2));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(3, sum(1, 2));
+  assertEquals(7, sum(3, 4));
+})();
+
+
+// Test that fields are merged across control flow.
+(function testJoin() {
+  function Box(v) { this.v = v; }
+  function select(c, a, b) {
+    var box = new Box(a);
+    if (c) box.v = b;
+    return box.v;
+  }
+  assertEquals(1, select(false, 1, 2));
+  assertEquals(2, select(true, 1, 2));
+  %OptimizeFunctionOnNextCall(select);
+  assertEquals(1, select(false, 1, 2));
+  assertEquals(2, select(true, 1, 2));
+})();
+
+
+// Test materialization of captured objects on deoptimization.
+(function testDeopt() {
+  function Pair(a, b) {
+    this.a = a;
+    this.b = b;
+  }
+  function f(a, b, o) {
+    var p = new Pair(a, b);
+    p.b = a + b;
+    o.x;  // Deoptimizes on a new map.
+    return p.a + p.b;
+  }
+  var o1 = { x: 1 };
+  var o2 = { y: 2, x: 1 };
+  assertEquals(4, f(1, 2, o1));
+  assertEquals(4, f(1, 2, o1));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(4, f(1, 2, o1));
+  assertEquals(5, f(1.5, 2, o2));
+})();
+
+
+// Test materialization of a captured object referenced from two slots.
+(function testDeoptDuplicate() {
+  function Cell(v) { this.v = v; }
+  function f(v, o) {
+    var c = new Cell(v);
+    var d = c;
+    o.x;  // Deoptimizes on a new map.
+    d.v = 2 * v;
+    return c.v;
+  }
+  var o1 = { x: 1 };
+  var o2 = { y: 2, x: 1 };
+  assertEquals(2, f(1, o1));
+  assertEquals(4, f(2, o1));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(6, f(3, o1));
+  assertEquals(8, f(4, o2));
+})();
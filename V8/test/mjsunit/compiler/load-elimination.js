@@ -0,0 +1,96 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --use-load-elimination
+
+// Test forwarding of stored values to later loads.
+(function testStoreToLoad() {
+  function f(o, a, b) {
+    o.x = a;
+    o.y = b;
+    return o.x + o.y;
+  }
+  assertEquals(3, f({ x: 0, y: 0 }, 1, 2));
+  assertEquals(3, f({ x: 0, y: 0 }, 1, 2));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(7, f({ x: 0, y: 0 }, 3, 4));
+})();
+
+
+// Test that stores through possibly aliasing objects kill known values.
+(function testAliasing() {
+  function f(o, p) {
+    o.x = 1;
+    p.x = 2;
+    return o.x;
+  }
+  var a = { x: 0 };
+  var b = { x: 0 };
+  assertEquals(1, f(a, b));
+  assertEquals(1, f(a, b));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(1, f(a, b));
+  assertEquals(2, f(a, a));
+})();
+
+
+// Test that calls kill known field values.
+(function testCall() {
+  var o = { x: 1 };
+  function g() { o.x++; }
+  function f(o) {
+    var a = o.x;
+    g();
+    return a + o.x;
+  }
+  assertEquals(3, f(o));
+  assertEquals(5, f(o));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(7, f(o));
+})();
+
+
+// Test removal of map checks dominated by earlier checks in loops.
+(function testLoopMapChecks() {
+  function f(o, n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += o.x;
+      o.y = i;
+      sum += o.x;
+    }
+    return sum;
+  }
+  var o = { x: 1, y: 0 };
+  assertEquals(20, f(o, 10));
+  assertEquals(20, f(o, 10));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(20, f(o, 10));
+  assertEquals(9, o.y);
+  o.z = 0;  // Changes the map.
+  assertEquals(20, f(o, 10));
+})();